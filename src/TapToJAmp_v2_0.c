@@ -32,9 +32,15 @@
 ********************************************************************************************/
 
 #include "screens/screens.h"    // NOTE: Defines global variable: currentScreen
+#include "screens/textcache.h"
+#include "screens/input.h"
 #include "raylib.h"
 //#define DEBUG
 
+#define SIMULATION_STEP (1.0/60.0) // Simulation step time (seconds), all the game motion values are per step
+#define MAX_FRAME_STEPS 6 // Max simulation steps per drawn frame (slower frames make the game run slower, not jump)
+#define REPLAY_FILE_NAME "replay.rpl" // Input of the last gameplay session (play it with: headless -r replay.rpl)
+
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h> 
 #endif
@@ -50,6 +56,11 @@ bool transFadeOut = false;
 int transFromScreen = -1;
 int transToScreen = -1;
 float alphaDiff = 0.05f;
+
+// Fixed timestep: simulation steps run at SIMULATION_STEP, frames are drawn at any rate (interpolated)
+double stepsAccumulator = 0; // Time not simulated yet
+double prevFrameTime = 0; // GetInputTime() of the last frame update (key events are timed on the same clock)
+float renderAlpha = 0;
     
 //----------------------------------------------------------------------------------
 // Local Functions Declaration
@@ -58,6 +69,7 @@ void TransitionToScreen(int screen);
 void UpdateTransition(void);
 void DrawTransition(void);
 void UpdateDrawFrame();
+void UpdateStep(void);
 
 //----------------------------------------------------------------------------------
 // Main entry point
@@ -70,7 +82,12 @@ int main(void)
     const int screenHeight = 576;
 	const char windowTitle[20] = "Tap To JAmp v2.0";
     
+    SetConfigFlags(FLAG_VSYNC_HINT); // Frames are drawn at the monitor refresh rate
     InitWindow(screenWidth, screenHeight, windowTitle);
+    InitGameInput();
+    prevFrameTime = GetInputTime();
+    
+    SetGameplayReplayFile(REPLAY_FILE_NAME);
     
     InitAudioDevice();
 
@@ -90,7 +107,6 @@ int main(void)
     emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
     #else
     
-	SetTargetFPS(60);
 	//----------------------------------------------------------
 
     // Main game loop
@@ -102,6 +118,10 @@ int main(void)
     // De-Initialization
     //--------------------------------------------------------------------------------------
     
+    if (currentScreen == GAMEPLAY) UnloadGameplayScreen(); // Saves the session replay
+    
+    UnloadTextCache();
+    CloseGameInput();
     CloseAudioDevice();
     
     CloseWindow();        // Close window and OpenGL context
@@ -196,10 +216,66 @@ void DrawTransition(void)
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, transAlpha));
 }
 
+float GetRenderAlpha(void)
+{
+    return renderAlpha;
+}
+
 void UpdateDrawFrame()
 {
-    // Update
+    // Update (as many simulation steps as the time passed since the last frame)
+    //----------------------------------------------------------------------------------
+    double frameTime = GetInputTime();
+    
+    stepsAccumulator += frameTime - prevFrameTime;
+    if (stepsAccumulator > MAX_FRAME_STEPS*SIMULATION_STEP) stepsAccumulator = MAX_FRAME_STEPS*SIMULATION_STEP;
+    prevFrameTime = frameTime;
+    
+    UpdateGameInput();
+    
+    while (stepsAccumulator >= SIMULATION_STEP)
+    {
+        stepsAccumulator -= SIMULATION_STEP;
+        
+        // Every step reads the key events that happened until its end time (frameTime - time not simulated yet)
+        BeginGameInputStep(frameTime - stepsAccumulator);
+        UpdateStep();
+        EndGameInputStep();
+    }
+    
+    renderAlpha = stepsAccumulator/SIMULATION_STEP;
+    //----------------------------------------------------------------------------------
+    
+    // Draw
     //----------------------------------------------------------------------------------
+    BeginDrawing();
+    
+        ClearBackground(RAYWHITE);
+        
+        switch(currentScreen) 
+        {
+            case LOADING: DrawLoadingScreen(); break;
+            case LOGO: DrawLogoScreen(); break;
+            case TITLE: DrawTitleScreen(); break;
+            case OPTIONS: DrawOptionsScreen(); break;
+            case GAMEPLAY: DrawGameplayScreen(); break;
+            case ENDING: DrawEndingScreen(); break;
+            default: break;
+        }
+        
+        if (onTransition) DrawTransition();
+        
+        DrawCachedText("@MarcMDE", 10, 10, 20, WHITE);
+        
+        //DrawFPS(GetScreenWidth() - 80, 5);
+    
+    EndDrawing();
+    //----------------------------------------------------------------------------------
+}
+
+// Simulation step (screens and transitions logic)
+void UpdateStep(void)
+{
     if (!onTransition)
     {
         switch(currentScreen) 
@@ -255,31 +331,4 @@ void UpdateDrawFrame()
         // Update transition (fade-in, fade-out)
         UpdateTransition();
     }
-    //----------------------------------------------------------------------------------
-    
-    // Draw
-    //----------------------------------------------------------------------------------
-    BeginDrawing();
-    
-        ClearBackground(RAYWHITE);
-        
-        switch(currentScreen) 
-        {
-            case LOADING: DrawLoadingScreen(); break;
-            case LOGO: DrawLogoScreen(); break;
-            case TITLE: DrawTitleScreen(); break;
-            case OPTIONS: DrawOptionsScreen(); break;
-            case GAMEPLAY: DrawGameplayScreen(); break;
-            case ENDING: DrawEndingScreen(); break;
-            default: break;
-        }
-        
-        if (onTransition) DrawTransition();
-        
-        DrawText("@MarcMDE", 10, 10, 20, WHITE);
-        
-        //DrawFPS(GetScreenWidth() - 80, 5);
-    
-    EndDrawing();
-    //----------------------------------------------------------------------------------
 }
\ No newline at end of file
@@ -0,0 +1,297 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - atlasc (sprites atlas packer)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Packs the gameplay sprites into a single atlas file (see screens/atlas.h), so the game
+*   uploads one texture and draws all the sprites on the same batch.
+*   Sprites are named by their file name without extension (assets/gameplay/tri_main.png -> "tri_main").
+*
+*   Usage: atlasc [-p padding] output.atlas sprite.png [sprite.png ...]
+*
+*       -p padding      Pixels around every sprite, filled with its border pixels (default: 1)
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "screens/atlas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SPRITES 64
+#define MIN_ATLAS_SIZE 64
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Sprite
+{
+    AtlasRect rect;
+    Color *pixels;
+} Sprite;
+
+//----------------------------------------------------------------------------------
+// Local Functions Declaration
+//----------------------------------------------------------------------------------
+static int LoadSprite(Sprite *sprite, const char *fileName);
+static int PackSprites(Sprite *sprites, int *order, int count, int padding, int width);
+static int GetNextPowerOfTwo(int value);
+static void DrawSprite(unsigned char *pixels, int atlasWidth, Sprite *sprite, int padding);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    const char *outputName = NULL;
+    const char *inputNames[MAX_SPRITES];
+    int inputsCount = 0;
+    int padding = 1;
+
+    Sprite sprites[MAX_SPRITES];
+    int order[MAX_SPRITES]; // Sprites sorted by height (packing order)
+    int errors = 0;
+
+    AtlasHeader header = { ATLAS_FILE_MAGIC, ATLAS_FILE_VERSION, 0, 0, 0 };
+    unsigned char *pixels;
+    FILE *outputFile;
+
+    for (int i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) padding = atoi(argv[++i]);
+        else if (outputName == NULL) outputName = argv[i];
+        else if (inputsCount < MAX_SPRITES) inputNames[inputsCount++] = argv[i];
+        else outputName = NULL;
+    }
+
+    if (outputName == NULL || inputsCount == 0 || padding < 0)
+    {
+        fprintf(stderr, "Usage: atlasc [-p padding] output.atlas sprite.png [sprite.png ...] (up to %i sprites)\n", MAX_SPRITES);
+        return 2;
+    }
+
+    for (int i=0; i<inputsCount; i++)
+    {
+        if (!LoadSprite(&sprites[i], inputNames[i]))
+        {
+            errors++;
+            continue;
+        }
+
+        for (int j=0; j<(int)header.rectsCount; j++)
+        {
+            if (strcmp(sprites[j].rect.name, sprites[i].rect.name) == 0)
+            {
+                fprintf(stderr, "%s: error: sprite name '%s' is already used\n", inputNames[i], sprites[i].rect.name);
+                errors++;
+            }
+        }
+
+        order[header.rectsCount] = header.rectsCount;
+        sprites[header.rectsCount++] = sprites[i];
+    }
+
+    if (errors > 0) return 1;
+
+    // Insertion sort by height, then width (tallest first)
+    for (int i=1; i<(int)header.rectsCount; i++)
+    {
+        int current = order[i];
+        int j = i - 1;
+
+        while (j >= 0 && (sprites[order[j]].rect.height < sprites[current].rect.height ||
+               (sprites[order[j]].rect.height == sprites[current].rect.height && sprites[order[j]].rect.width < sprites[current].rect.width)))
+        {
+            order[j + 1] = order[j];
+            j--;
+        }
+
+        order[j + 1] = current;
+    }
+
+    // Smallest power of two atlas (area, then width) that fits all the sprites
+    for (int width=MIN_ATLAS_SIZE; width<=ATLAS_MAX_SIZE; width*=2)
+    {
+        int height = PackSprites(sprites, order, header.rectsCount, padding, width);
+
+        if (height > 0)
+        {
+            height = GetNextPowerOfTwo(height);
+
+            if (height <= ATLAS_MAX_SIZE && (header.width == 0 || width*height < header.width*header.height))
+            {
+                header.width = width;
+                header.height = height;
+            }
+        }
+    }
+
+    if (header.width == 0)
+    {
+        fprintf(stderr, "%s: error: sprites don't fit on a %ix%i atlas\n", outputName, ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+        return 1;
+    }
+
+    PackSprites(sprites, order, header.rectsCount, padding, header.width);
+
+    pixels = calloc(header.width*header.height, 4);
+
+    for (int i=0; i<(int)header.rectsCount; i++)
+    {
+        DrawSprite(pixels, header.width, &sprites[i], padding);
+        printf("%s: %ix%i at (%i, %i)\n", sprites[i].rect.name, sprites[i].rect.width, sprites[i].rect.height, sprites[i].rect.x, sprites[i].rect.y);
+        free(sprites[i].pixels);
+    }
+
+    outputFile = fopen(outputName, "wb");
+
+    if (outputFile == NULL || fwrite(&header, sizeof(AtlasHeader), 1, outputFile) != 1) errors++;
+    else
+    {
+        for (int i=0; i<(int)header.rectsCount; i++)
+        {
+            if (fwrite(&sprites[i].rect, sizeof(AtlasRect), 1, outputFile) != 1) errors++;
+        }
+
+        if (fwrite(pixels, 4, header.width*header.height, outputFile) != header.width*header.height) errors++;
+    }
+
+    if (outputFile != NULL) fclose(outputFile);
+    free(pixels);
+
+    if (errors > 0)
+    {
+        fprintf(stderr, "%s: error: could not write the atlas file\n", outputName);
+        remove(outputName);
+        return 1;
+    }
+
+    printf("%s: %u sprites, %ux%u atlas\n", outputName, header.rectsCount, header.width, header.height);
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Local Functions Definition
+//----------------------------------------------------------------------------------
+
+// Loads the sprite pixels with raylib and names it by its file name
+static int LoadSprite(Sprite *sprite, const char *fileName)
+{
+    const char *name = strrchr(fileName, '/');
+    const char *extension;
+    int lenght;
+    Image image;
+
+    name = (name != NULL) ? name + 1 : fileName;
+    extension = strrchr(name, '.');
+    lenght = (extension != NULL) ? (int)(extension - name) : (int)strlen(name);
+
+    if (lenght >= ATLAS_NAME_LENGHT)
+    {
+        fprintf(stderr, "%s: error: sprite name is longer than %i characters\n", fileName, ATLAS_NAME_LENGHT - 1);
+        return 0;
+    }
+
+    image = LoadImage(fileName);
+
+    if (image.data == NULL || image.width <= 0 || image.height <= 0)
+    {
+        fprintf(stderr, "%s: error: could not load image\n", fileName);
+        return 0;
+    }
+
+    memset(&sprite->rect, 0, sizeof(AtlasRect));
+    memcpy(sprite->rect.name, name, lenght);
+    sprite->rect.width = image.width;
+    sprite->rect.height = image.height;
+    sprite->pixels = GetImageData(image); // Remember to free
+
+    UnloadImage(image);
+
+    return (sprite->pixels != NULL);
+}
+
+// Places the sprites on rows (shelves) of the given width, returns the used height (0 if a sprite doesn't fit)
+static int PackSprites(Sprite *sprites, int *order, int count, int padding, int width)
+{
+    int x = 0;
+    int y = 0;
+    int rowHeight = 0;
+
+    for (int i=0; i<count; i++)
+    {
+        AtlasRect *rect = &sprites[order[i]].rect;
+        int paddedWidth = rect->width + padding*2;
+        int paddedHeight = rect->height + padding*2;
+
+        if (paddedWidth > width) return 0;
+
+        if (x + paddedWidth > width)
+        {
+            // Next row
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+
+        rect->x = x + padding;
+        rect->y = y + padding;
+
+        x += paddedWidth;
+        if (paddedHeight > rowHeight) rowHeight = paddedHeight;
+    }
+
+    return y + rowHeight;
+}
+
+static int GetNextPowerOfTwo(int value)
+{
+    int power = 1;
+
+    while (power < value) power *= 2;
+
+    return power;
+}
+
+// Copies the sprite pixels and extends its border pixels over the padding (no bleeding when filtering)
+static void DrawSprite(unsigned char *pixels, int atlasWidth, Sprite *sprite, int padding)
+{
+    AtlasRect *rect = &sprite->rect;
+
+    for (int y=-padding; y<rect->height + padding; y++)
+    {
+        int spriteY = (y < 0) ? 0 : ((y >= rect->height) ? rect->height - 1 : y);
+
+        for (int x=-padding; x<rect->width + padding; x++)
+        {
+            int spriteX = (x < 0) ? 0 : ((x >= rect->width) ? rect->width - 1 : x);
+            Color color = sprite->pixels[spriteY*rect->width + spriteX];
+            unsigned char *pixel = &pixels[((rect->y + y)*atlasWidth + rect->x + x)*4];
+
+            pixel[0] = color.r;
+            pixel[1] = color.g;
+            pixel[2] = color.b;
+            pixel[3] = color.a;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - hashcmp (state hash streams compare tool)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Compares two state hash streams (headless -s, see screens/statehash.h) and reports the first
+*   simulation step where they diverge, so desyncs between replays, headless runs or builds of
+*   other compilers are found on the step they start.
+*
+*   Usage: hashcmp first.hsh second.hsh
+*
+*   Exit code: 0 same hashes, 1 the runs diverge (or one stream is shorter), 2 bad arguments or streams
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "screens/statehash.h"
+#include <stdio.h>
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    StateHashHeader headers[2];
+    FILE *streams[2];
+    unsigned long long hashes[2];
+    int hasHash[2];
+    int step = 0;
+    int result = 0;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: hashcmp first.hsh second.hsh\n");
+        return 2;
+    }
+
+    for (int i=0; i<2; i++)
+    {
+        streams[i] = LoadStateHashStream(argv[i + 1], &headers[i]);
+
+        if (streams[i] == NULL)
+        {
+            fprintf(stderr, "%s: error: could not load state hash stream\n", argv[i + 1]);
+            if (i == 1) fclose(streams[0]);
+            return 2;
+        }
+    }
+
+    // Different levels or seeds are reported, but hashes are still compared (the first steps can match)
+    if (headers[0].levelHash != headers[1].levelHash) printf("warning: runs on different levels (%016llx, %016llx)\n", headers[0].levelHash, headers[1].levelHash);
+    if (headers[0].seed != headers[1].seed) printf("warning: runs with different seeds (%u, %u)\n", headers[0].seed, headers[1].seed);
+
+    for (;;)
+    {
+        hasHash[0] = ReadStateHash(streams[0], &hashes[0]);
+        hasHash[1] = ReadStateHash(streams[1], &hashes[1]);
+
+        if (!hasHash[0] || !hasHash[1])
+        {
+            if (hasHash[0] != hasHash[1])
+            {
+                printf("same hashes for %i steps, %s ends first\n", step, argv[hasHash[0] ? 2 : 1]);
+                result = 1;
+            }
+            else printf("same hashes, %i steps\n", step);
+
+            break;
+        }
+
+        if (hashes[0] != hashes[1])
+        {
+            printf("first divergent step: %i (%016llx, %016llx)\n", step, hashes[0], hashes[1]);
+            result = 1;
+            break;
+        }
+
+        step++;
+    }
+
+    fclose(streams[0]);
+    fclose(streams[1]);
+
+    return result;
+}
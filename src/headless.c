@@ -0,0 +1,325 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - headless (gameplay simulation without window, GPU or audio device)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Runs the gameplay screen simulation steps as fast as the CPU allows, with the keys read from
+*   an input script, and reports the simulated frames per second, the death frame and if the
+*   level was completed. Linked with raylib_headless.c instead of raylib (see makefile), so it
+*   runs on machines without display or audio (level checks and performance regressions).
+*
+*   Usage: headless [-f maxFrames] [-c] [-o output.rpl] [-s hashes.hsh] [-l level.lvl] (script.txt | -r replay.rpl)
+*
+*       -f maxFrames    Simulation steps to run before giving up (default: 36000, 10 minutes, or the replay steps)
+*       -c              Continue after dying (the input restarts the level), every death is reported
+*       -o output.rpl   Save the simulated input as a replay (see screens/replay.h)
+*       -r replay.rpl   Simulate a recorded replay (game or -o) instead of a script, with its seed and on its level
+*       -s hashes.hsh   Write the state hash of every simulation step (compare two runs with hashcmp)
+*       -l level.lvl    Play a compiled level instead of the game one (e.g. mapgen levels, see make bench)
+*
+*   Input script: one key change per line, sorted by frame (simulation step, 0 is the first one)
+*
+*       # frame key action          keys: SPACE ENTER LEFT RIGHT P R C, actions: down up
+*       0 SPACE down
+*       1 SPACE up
+*
+*   Exit code: 0 level completed, 1 not completed (player died or frames limit), 2 bad arguments, script or replay
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "screens/screens.h"
+#include "screens/input.h"
+#include "screens/replay.h"
+#include "screens/statehash.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// NOTE: Must match TapToJAmp_v2_0.c
+#define SIMULATION_STEP (1.0/60.0)
+
+#define DEFAULT_MAX_FRAMES (60*60*10)
+#define SCRIPT_LINE_LENGHT 128
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ScriptEvent
+{
+    int frame;
+    int key;
+    bool isDown;
+} ScriptEvent;
+
+typedef struct ScriptKey
+{
+    const char *name;
+    int key;
+} ScriptKey;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition (local to this module)
+//----------------------------------------------------------------------------------
+static const ScriptKey scriptKeys[] = {
+    { "SPACE", KEY_SPACE }, { "ENTER", KEY_ENTER }, { "LEFT", KEY_LEFT }, { "RIGHT", KEY_RIGHT }, { "P", 'P' }, { "R", 'R' }, { "C", 'C' }
+};
+
+//----------------------------------------------------------------------------------
+// Local Functions Declaration
+//----------------------------------------------------------------------------------
+static ScriptEvent *LoadScript(const char *fileName, int *count);
+static int GetScriptKey(const char *name);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    const char *scriptName = NULL;
+    const char *replayName = NULL;
+    const char *outputName = NULL;
+    const char *hashesName = NULL;
+    const char *levelName = NULL;
+    FILE *hashesStream = NULL;
+    int maxFrames = 0;
+    bool isDeathFinal = true;
+
+    ScriptEvent *events = NULL;
+    int eventsCount = 0;
+    int nextEvent = 0;
+    Replay replay = { 0 };
+
+    int frame;
+    int deathFrame = -1;
+    int deathsCount = 0;
+    bool isCompleted = false;
+    bool wasPlayerAlive = true;
+    double startTime, seconds;
+
+    for (int i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) maxFrames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0) isDeathFinal = false;
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputName = argv[++i];
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) hashesName = argv[++i];
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) levelName = argv[++i];
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc && replayName == NULL) replayName = argv[++i];
+        else if (scriptName == NULL) scriptName = argv[i];
+        else maxFrames = -1;
+    }
+
+    if ((scriptName == NULL) == (replayName == NULL) || maxFrames < 0)
+    {
+        fprintf(stderr, "Usage: headless [-f maxFrames] [-c] [-o output.rpl] [-s hashes.hsh] [-l level.lvl] (script.txt | -r replay.rpl)\n");
+        return 2;
+    }
+
+    if (replayName != NULL)
+    {
+        if (!LoadReplay(&replay, replayName))
+        {
+            fprintf(stderr, "%s: error: could not load replay\n", replayName);
+            return 2;
+        }
+
+        if (maxFrames == 0) maxFrames = replay.stepsCount;
+        SetGameplaySeed(replay.seed);
+    }
+    else
+    {
+        events = LoadScript(scriptName, &eventsCount);
+        if (events == NULL) return 2;
+    }
+
+    if (maxFrames == 0) maxFrames = DEFAULT_MAX_FRAMES;
+
+    SetGameplayReplayFile(outputName);
+    SetGameplayLevelFile(levelName);
+    InitGameplayScreen();
+
+    if (replayName != NULL && GetGameplayLevelHash() != replay.levelHash)
+    {
+        fprintf(stderr, "%s: error: replay was recorded on another level (level hash %016llx, replay %016llx)\n", replayName, GetGameplayLevelHash(), replay.levelHash);
+        SetGameplayReplayFile(NULL);
+        UnloadGameplayScreen();
+        UnloadReplay(&replay);
+        return 2;
+    }
+
+    if (hashesName != NULL)
+    {
+        hashesStream = OpenStateHashStream(hashesName, GetGameplayLevelHash(), GetGameplaySeed());
+
+        if (hashesStream == NULL)
+        {
+            fprintf(stderr, "%s: error: could not write state hashes\n", hashesName);
+            SetGameplayReplayFile(NULL);
+            UnloadGameplayScreen();
+            UnloadReplay(&replay);
+            return 2;
+        }
+    }
+
+    startTime = GetInputTime();
+
+    for (frame=0; frame<maxFrames; frame++)
+    {
+        if (replayName != NULL) SetGameInputState(GetReplayInput(&replay, frame)); // Recorded keys of the step, as the simulation read them
+        else
+        {
+            // Scripted keys are timed on their step, so every step applies the ones of its frame
+            while (nextEvent < eventsCount && events[nextEvent].frame == frame)
+            {
+                PushGameKeyEvent(frame*SIMULATION_STEP, events[nextEvent].key, events[nextEvent].isDown);
+                nextEvent++;
+            }
+
+            BeginGameInputStep(frame*SIMULATION_STEP);
+        }
+
+        UpdateGameplayScreen();
+        EndGameInputStep();
+
+        if (hashesStream != NULL) WriteStateHash(hashesStream, GetGameplayStateHash());
+
+        if (wasPlayerAlive && !IsGameplayPlayerAlive())
+        {
+            if (deathFrame < 0) deathFrame = frame;
+            deathsCount++;
+
+            printf("death: frame %i (attempt %i)\n", frame, GetGameplayAttempts());
+
+            if (isDeathFinal)
+            {
+                frame++;
+                break;
+            }
+        }
+
+        wasPlayerAlive = IsGameplayPlayerAlive();
+
+        if (FinishGameplayScreen())
+        {
+            isCompleted = true;
+            frame++;
+            break;
+        }
+    }
+
+    seconds = GetInputTime() - startTime;
+
+    UnloadGameplayScreen();
+    UnloadReplay(&replay);
+    free(events);
+
+    if (hashesStream != NULL && !CloseStateHashStream(hashesStream))
+    {
+        fprintf(stderr, "%s: error: could not write state hashes\n", hashesName);
+        return 2;
+    }
+
+    printf("frames: %i\n", frame);
+    printf("frames per second: %.0f\n", (seconds > 0) ? frame/seconds : 0);
+    printf("death frame: %i\n", deathFrame);
+    printf("deaths: %i\n", deathsCount);
+    printf("completed: %s\n", isCompleted ? "yes" : "no");
+
+    return isCompleted ? 0 : 1;
+}
+
+// Simulation steps are run right away, frames are never drawn
+float GetRenderAlpha(void)
+{
+    return 1;
+}
+
+//----------------------------------------------------------------------------------
+// Local Functions Definition
+//----------------------------------------------------------------------------------
+
+// Loads the script key changes (sorted by frame), returns NULL on error (remember to free)
+static ScriptEvent *LoadScript(const char *fileName, int *count)
+{
+    FILE *file = fopen(fileName, "r");
+    ScriptEvent *events = NULL;
+    int capacity = 0;
+    int lineNumber = 0;
+    char line[SCRIPT_LINE_LENGHT];
+
+    *count = 0;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s: error: could not open script\n", fileName);
+        return NULL;
+    }
+
+    while (fgets(line, SCRIPT_LINE_LENGHT, file) != NULL)
+    {
+        char keyName[16];
+        char action[8];
+        ScriptEvent event;
+        int fields;
+
+        lineNumber++;
+
+        fields = sscanf(line, " %i %15s %7s", &event.frame, keyName, action);
+
+        if (fields <= 0 || line[strspn(line, " \t")] == '#') continue; // Empty line or comment
+
+        event.key = (fields == 3) ? GetScriptKey(keyName) : -1;
+        event.isDown = (fields == 3 && strcmp(action, "down") == 0);
+
+        if (event.key < 0 || (!event.isDown && strcmp(action, "up") != 0) || event.frame < 0 ||
+            (*count > 0 && event.frame < events[*count - 1].frame))
+        {
+            fprintf(stderr, "%s:%i: error: expected 'frame key down|up' (frames in order)\n", fileName, lineNumber);
+            free(events);
+            fclose(file);
+            return NULL;
+        }
+
+        if (*count == capacity)
+        {
+            capacity = (capacity == 0) ? 64 : capacity*2;
+            events = realloc(events, sizeof(ScriptEvent)*capacity);
+        }
+
+        events[(*count)++] = event;
+    }
+
+    fclose(file);
+
+    if (events == NULL) events = malloc(sizeof(ScriptEvent)); // Empty script, never pressed
+
+    return events;
+}
+
+static int GetScriptKey(const char *name)
+{
+    for (int i=0; i<(int)(sizeof(scriptKeys)/sizeof(scriptKeys[0])); i++)
+    {
+        if (strcmp(scriptKeys[i].name, name) == 0) return scriptKeys[i].key;
+    }
+
+    return -1;
+}
@@ -0,0 +1,454 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - levelc (level compiler)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Compiles the authoring map bitmaps (maps folder) into the runtime level format (see screens/level.h)
+*   and validates them, so the game never has to classify pixels on startup.
+*
+*   Usage: levelc [-b budget] [-w screenWidth] [-s] input.bmp [output.lvl]
+*
+*       -b budget       Fail if more than 'budget' objects can be visible at once (default: no limit)
+*       -w screenWidth  Screen width used to estimate the visible window (default: 1024)
+*       -s              Strict mode, warnings are treated as errors
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "screens/level.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// NOTE: Must match screen_gameplay.c
+#define CELL_SIZE 48
+#define PLAYER_COLUMN 5
+#define PLAYER_ROW 2 // From the bottom
+#define GROUND_ROWS 2 // Rows under the ground (from the bottom)
+
+#define MAX_UNKNOWN_COLORS 8
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct UnknownColor
+{
+    unsigned char rgba[4];
+    int count;
+    int x, y; // First pixel found
+} UnknownColor;
+
+//----------------------------------------------------------------------------------
+// Local Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned char *LoadBitmap(const char *fileName, int *width, int *height);
+static int IsEmptyPixel(const unsigned char *pixel);
+static int ValidateMap(const char *fileName, const unsigned char *pixels, int width, int height, int *warnings);
+static void PrintLevelStats(const Level *level, int screenWidth, int *maxVisible);
+static int GetMaxZoneObjects(const unsigned int *columnOffset, int width, int *column);
+static unsigned int ReadU16(const unsigned char *data);
+static unsigned int ReadU32(const unsigned char *data);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    const char *inputName = NULL;
+    const char *outputName = NULL;
+    char defaultOutputName[512];
+
+    int budget = -1;
+    int screenWidth = 1024;
+    int isStrict = 0;
+
+    unsigned char *pixels;
+    int width, height;
+    int errors, warnings = 0;
+    int maxVisible;
+
+    Level level;
+    FILE *outputFile;
+
+    for (int i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) budget = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) screenWidth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0) isStrict = 1;
+        else if (inputName == NULL) inputName = argv[i];
+        else if (outputName == NULL) outputName = argv[i];
+        else inputName = NULL;
+    }
+
+    if (inputName == NULL || screenWidth <= 0)
+    {
+        fprintf(stderr, "Usage: levelc [-b budget] [-w screenWidth] [-s] input.bmp [output.lvl]\n");
+        return 2;
+    }
+
+    if (outputName == NULL)
+    {
+        // Same name, .lvl extension
+        const char *extension = strrchr(inputName, '.');
+        int lenght = (extension != NULL) ? (int)(extension - inputName) : (int)strlen(inputName);
+
+        if (lenght > (int)sizeof(defaultOutputName) - 5) lenght = sizeof(defaultOutputName) - 5;
+        memcpy(defaultOutputName, inputName, lenght);
+        strcpy(defaultOutputName + lenght, ".lvl");
+        outputName = defaultOutputName;
+    }
+
+    pixels = LoadBitmap(inputName, &width, &height);
+    if (pixels == NULL) return 1;
+
+    errors = ValidateMap(inputName, pixels, width, height, &warnings);
+
+    if (errors == 0 && !LoadLevelFromPixels(&level, pixels, width, height))
+    {
+        fprintf(stderr, "%s: error: could not compile the level\n", inputName);
+        errors++;
+    }
+    else if (errors == 0)
+    {
+        printf("%s: %ix%i cells, %u tris, %u platfs, %u bytes\n", inputName, width, height,
+               level.header->trisCount, level.header->platfsCount, level.size);
+        PrintLevelStats(&level, screenWidth, &maxVisible);
+
+        if (budget >= 0 && maxVisible > budget)
+        {
+            fprintf(stderr, "%s: error: up to %i objects visible at once, budget is %i\n", inputName, maxVisible, budget);
+            errors++;
+        }
+
+        // Same worst-case zone than the gameplay one (GetZoneCapacity()), dense zones make every frame collisions slower
+        for (int i=0; i<2; i++)
+        {
+            int column;
+            int maxZone = GetMaxZoneObjects((i == 0) ? level.trisColumnOffset : level.platfsColumnOffset, width, &column);
+
+            if (maxZone > MAX_ZONE_COLLIDERS)
+            {
+                fprintf(stderr, "%s: error: up to %i %s on the player collision zone (%i columns from column %i), maximum is %i\n",
+                        inputName, maxZone, (i == 0) ? "tris" : "platfs", ZONE_MAX_COLUMNS, column, MAX_ZONE_COLLIDERS);
+                errors++;
+            }
+        }
+
+        if (errors == 0 && (warnings == 0 || !isStrict))
+        {
+            outputFile = fopen(outputName, "wb");
+
+            if (outputFile == NULL || fwrite(level.data, 1, level.size, outputFile) != level.size)
+            {
+                fprintf(stderr, "%s: error: could not write the level file\n", outputName);
+                errors++;
+            }
+
+            if (outputFile != NULL) fclose(outputFile);
+        }
+
+        UnloadLevel(&level);
+    }
+
+    free(pixels);
+
+    if (errors > 0 || (warnings > 0 && isStrict))
+    {
+        fprintf(stderr, "%s: %i error(s), %i warning(s)\n", inputName, errors, warnings);
+        remove(outputName);
+        return 1;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Local Functions Definition
+//----------------------------------------------------------------------------------
+
+// Loads an uncompressed BMP (8 bit paletted, 24 or 32 bit) as RGBA top-down pixels
+static unsigned char *LoadBitmap(const char *fileName, int *width, int *height)
+{
+    FILE *file;
+    long fileSize;
+    unsigned char *data;
+    unsigned char *pixels = NULL;
+
+    file = fopen(fileName, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s: error: could not open file\n", fileName);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    data = malloc(fileSize);
+    if (data == NULL || fread(data, 1, fileSize, file) != (size_t)fileSize) fileSize = 0;
+    fclose(file);
+
+    if (fileSize >= 54 && data[0] == 'B' && data[1] == 'M')
+    {
+        unsigned int pixelsOffset = ReadU32(data + 10);
+        unsigned int infoSize = ReadU32(data + 14);
+        int bmpWidth = (int)ReadU32(data + 18);
+        int bmpHeight = (int)ReadU32(data + 22);
+        unsigned int bpp = ReadU16(data + 28);
+        unsigned int compression = ReadU32(data + 30);
+        unsigned int paletteColors = ReadU32(data + 46);
+        int isTopDown = bmpHeight < 0;
+        int masksCount = (compression == 3) ? ((infoSize >= 56) ? 4 : 3) : 0; // Bit fields masks (alpha one only on V4/V5 headers)
+        int rowSize;
+
+        if (isTopDown) bmpHeight = -bmpHeight;
+        if (paletteColors == 0) paletteColors = 256;
+        rowSize = ((bmpWidth*bpp + 31)/32)*4;
+
+        if (bmpWidth <= 0 || bmpHeight <= 0 || (bpp != 8 && bpp != 24 && bpp != 32) ||
+            !(compression == 0 || (compression == 3 && bpp == 32)) ||
+            pixelsOffset + (long)rowSize*bmpHeight > fileSize || (bpp == 8 && 14 + infoSize + paletteColors*4 > pixelsOffset) ||
+            54 + masksCount*4 > fileSize)
+        {
+            fprintf(stderr, "%s: error: unsupported bitmap (%ix%i, %u bpp, compression %u)\n", fileName, bmpWidth, bmpHeight, bpp, compression);
+        }
+        else
+        {
+            const unsigned char *palette = data + 14 + infoSize;
+            unsigned int masks[4] = { 0x00ff0000, 0x0000ff00, 0x000000ff, 0 };
+            int shifts[4];
+
+            if (compression == 3)
+            {
+                // Bit fields masks, follow the info header (or inside it, for V4/V5 headers)
+                for (int i=0; i<4; i++) masks[i] = (i < masksCount) ? ReadU32(data + 54 + i*4) : 0;
+            }
+
+            for (int i=0; i<4; i++)
+            {
+                shifts[i] = 0;
+                while (masks[i] != 0 && !((masks[i] >> shifts[i]) & 1)) shifts[i]++;
+            }
+
+            pixels = malloc(bmpWidth*bmpHeight*4); // Remember to free
+
+            for (int y=0; y<bmpHeight; y++)
+            {
+                const unsigned char *row = data + pixelsOffset + rowSize*(isTopDown ? y : bmpHeight - 1 - y);
+
+                for (int x=0; x<bmpWidth; x++)
+                {
+                    unsigned char *pixel = &pixels[(y*bmpWidth + x)*4];
+
+                    if (bpp == 8)
+                    {
+                        const unsigned char *color = &palette[(row[x] % paletteColors)*4];
+                        pixel[0] = color[2];
+                        pixel[1] = color[1];
+                        pixel[2] = color[0];
+                        pixel[3] = 255;
+                    }
+                    else if (bpp == 24)
+                    {
+                        pixel[0] = row[x*3 + 2];
+                        pixel[1] = row[x*3 + 1];
+                        pixel[2] = row[x*3];
+                        pixel[3] = 255;
+                    }
+                    else
+                    {
+                        unsigned int value = ReadU32(row + x*4);
+
+                        for (int i=0; i<3; i++) pixel[i] = (value & masks[i]) >> shifts[i];
+                        pixel[3] = (masks[3] != 0) ? (value & masks[3]) >> shifts[3] : 255;
+                    }
+                }
+            }
+
+            *width = bmpWidth;
+            *height = bmpHeight;
+        }
+    }
+    else fprintf(stderr, "%s: error: not a BMP file\n", fileName);
+
+    free(data);
+
+    return pixels;
+}
+
+// Map background: white, black or transparent pixels
+static int IsEmptyPixel(const unsigned char *pixel)
+{
+    if (pixel[3] == 0) return 1;
+    if (pixel[0] == 255 && pixel[1] == 255 && pixel[2] == 255) return 1;
+    if (pixel[0] == 0 && pixel[1] == 0 && pixel[2] == 0) return 1;
+
+    return 0;
+}
+
+// Returns the number of errors, prints every problem found
+static int ValidateMap(const char *fileName, const unsigned char *pixels, int width, int height, int *warnings)
+{
+    UnknownColor unknownColors[MAX_UNKNOWN_COLORS];
+    int unknownColorsCount = 0;
+    int unknownPixels = 0;
+    int errors = 0;
+
+    if (width > LEVEL_MAX_WIDTH || height > LEVEL_MAX_HEIGHT)
+    {
+        fprintf(stderr, "%s: error: map is %ix%i cells, maximum is %ix%i\n", fileName, width, height, LEVEL_MAX_WIDTH, LEVEL_MAX_HEIGHT);
+        return 1;
+    }
+
+    if (width <= PLAYER_COLUMN || height <= PLAYER_ROW)
+    {
+        fprintf(stderr, "%s: error: map is %ix%i cells, the player start cell (%i, %i) is out of the map\n", fileName, width, height, PLAYER_COLUMN, height - 1 - PLAYER_ROW);
+        return 1;
+    }
+
+    for (int y=0; y<height; y++)
+    {
+        for (int x=0; x<width; x++)
+        {
+            const unsigned char *pixel = &pixels[(y*width + x)*4];
+            int type = GetLevelCellType(pixel);
+
+            if (type == LEVEL_CELL_EMPTY)
+            {
+                if (!IsEmptyPixel(pixel))
+                {
+                    int i = 0;
+
+                    while (i < unknownColorsCount && memcmp(unknownColors[i].rgba, pixel, 4) != 0) i++;
+
+                    if (i == unknownColorsCount && unknownColorsCount < MAX_UNKNOWN_COLORS)
+                    {
+                        memcpy(unknownColors[i].rgba, pixel, 4);
+                        unknownColors[i].count = 0;
+                        unknownColors[i].x = x;
+                        unknownColors[i].y = y;
+                        unknownColorsCount++;
+                    }
+
+                    if (i < unknownColorsCount) unknownColors[i].count++;
+                    unknownPixels++;
+                }
+            }
+            else if (x == PLAYER_COLUMN && y == height - 1 - PLAYER_ROW)
+            {
+                fprintf(stderr, "%s: error: cell (%i, %i) overlaps the player start position\n", fileName, x, y);
+                errors++;
+            }
+            else if (y >= height - GROUND_ROWS)
+            {
+                fprintf(stderr, "%s: warning: cell (%i, %i) is under the ground, it will never be reached\n", fileName, x, y);
+                (*warnings)++;
+            }
+        }
+    }
+
+    for (int i=0; i<unknownColorsCount; i++)
+    {
+        fprintf(stderr, "%s: warning: unknown color (%i, %i, %i, %i) on %i cell(s), first one at (%i, %i), ignored\n", fileName,
+                unknownColors[i].rgba[0], unknownColors[i].rgba[1], unknownColors[i].rgba[2], unknownColors[i].rgba[3],
+                unknownColors[i].count, unknownColors[i].x, unknownColors[i].y);
+    }
+
+    if (unknownColorsCount == MAX_UNKNOWN_COLORS) fprintf(stderr, "%s: warning: %i cell(s) with unknown colors in total\n", fileName, unknownPixels);
+
+    *warnings += unknownColorsCount;
+
+    return errors;
+}
+
+// Estimates the per-frame work: objects on the grid columns the game visits for a camera position
+static void PrintLevelStats(const Level *level, int screenWidth, int *maxVisible)
+{
+    // Same columns range than UpdateVisibleColumns(): one extra column on each side
+    int windowColumns = (screenWidth + CELL_SIZE - 1)/CELL_SIZE + 2;
+    int width = level->header->width;
+    int maxTris = 0, maxPlatfs = 0, maxColumn = 0;
+    int columnCells = 0;
+    long totalVisible = 0;
+
+    if (windowColumns > width) windowColumns = width;
+
+    *maxVisible = 0;
+
+    for (int x=0; x + windowColumns <= width; x++)
+    {
+        int tris = level->trisColumnOffset[x + windowColumns] - level->trisColumnOffset[x];
+        int platfs = level->platfsColumnOffset[x + windowColumns] - level->platfsColumnOffset[x];
+
+        if (tris + platfs > *maxVisible)
+        {
+            *maxVisible = tris + platfs;
+            maxColumn = x;
+        }
+        if (tris > maxTris) maxTris = tris;
+        if (platfs > maxPlatfs) maxPlatfs = platfs;
+
+        totalVisible += tris + platfs;
+    }
+
+    for (int x=0; x<width; x++)
+    {
+        int cells = (level->trisColumnOffset[x + 1] - level->trisColumnOffset[x]) + (level->platfsColumnOffset[x + 1] - level->platfsColumnOffset[x]);
+        if (cells > columnCells) columnCells = cells;
+    }
+
+    printf("  visible window:    %i columns (%i px screen)\n", windowColumns, screenWidth);
+    printf("  max visible:       %i objects (%i tris, %i platfs max), from column %i\n", *maxVisible, maxTris, maxPlatfs, maxColumn);
+    printf("  mean visible:      %.1f objects\n", (width - windowColumns + 1 > 0) ? (float)totalVisible/(width - windowColumns + 1) : 0.0f);
+    printf("  max column cells:  %i\n", columnCells);
+}
+
+// Max objects on ZONE_MAX_COLUMNS consecutive grid columns (and the first of those columns)
+static int GetMaxZoneObjects(const unsigned int *columnOffset, int width, int *column)
+{
+    int maxObjects = 0;
+
+    *column = 0;
+
+    for (int x=0; x<width; x++)
+    {
+        int lastColumn = (x + ZONE_MAX_COLUMNS < width) ? x + ZONE_MAX_COLUMNS : width;
+        int objects = columnOffset[lastColumn] - columnOffset[x];
+
+        if (objects > maxObjects)
+        {
+            maxObjects = objects;
+            *column = x;
+        }
+    }
+
+    return maxObjects;
+}
+
+static unsigned int ReadU16(const unsigned char *data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+static unsigned int ReadU32(const unsigned char *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24);
+}
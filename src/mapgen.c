@@ -0,0 +1,152 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - mapgen (benchmark levels generator)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Generates a compiled level (see screens/level.h) with random tris and platfs, as big and dense
+*   as needed to measure the per-step work (visible columns culling, collision zones). Cells are only
+*   placed on the top rows, out of the player jump, so the level can be run to its end without input
+*   (see make bench).
+*
+*   Usage: mapgen [-w width] [-h height] [-d density] [-s seed] output.lvl
+*
+*       -w width        Grid columns (default: 16384)
+*       -h height       Grid rows (default: 64)
+*       -d density      Percentage of the top rows cells with an object (default: 50)
+*       -s seed         Random seed, the same seed generates the same level (default: 1)
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "screens/level.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_WIDTH 16384
+#define DEFAULT_HEIGHT 64
+#define DEFAULT_DENSITY 50
+
+#define FREE_ROWS 8 // Bottom rows left empty: ground, player start row and the player jump (with margin)
+
+//----------------------------------------------------------------------------------
+// Local Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandom(unsigned int *state);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    const char *outputName = NULL;
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+    int density = DEFAULT_DENSITY;
+    unsigned int seed = 1;
+
+    unsigned char *pixels;
+    unsigned char *data;
+    unsigned int size;
+    const LevelHeader *header;
+    FILE *outputFile;
+
+    for (int i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-h") == 0 && i + 1 < argc) height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) density = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = strtoul(argv[++i], NULL, 10);
+        else if (outputName == NULL) outputName = argv[i];
+        else outputName = NULL;
+    }
+
+    if (outputName == NULL || width <= 0 || width > LEVEL_MAX_WIDTH || height <= FREE_ROWS || height > LEVEL_MAX_HEIGHT || density < 0 || density > 100)
+    {
+        fprintf(stderr, "Usage: mapgen [-w width] [-h height] [-d density] [-s seed] output.lvl\n");
+        fprintf(stderr, "       width up to %i, height from %i to %i, density from 0 to 100\n", LEVEL_MAX_WIDTH, FREE_ROWS + 1, LEVEL_MAX_HEIGHT);
+        return 2;
+    }
+
+    if (seed == 0) seed = 1;
+
+    // Map pixels, as a map bitmap (see GetLevelCellType): empty, red tris and green platfs
+    pixels = calloc((size_t)width*height, 4);
+
+    for (int y=0; y<height - FREE_ROWS; y++)
+    {
+        for (int x=0; x<width; x++)
+        {
+            unsigned int value = GetRandom(&seed);
+
+            if ((int)(value%100) < density)
+            {
+                unsigned char *pixel = &pixels[((size_t)y*width + x)*4];
+
+                pixel[((value >> 8) & 1) ? 0 : 1] = 255;
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    data = CompileLevel(pixels, width, height, &size);
+    free(pixels);
+
+    if (data == NULL)
+    {
+        fprintf(stderr, "%s: error: could not compile the level\n", outputName);
+        return 1;
+    }
+
+    header = (const LevelHeader *)data;
+
+    outputFile = fopen(outputName, "wb");
+
+    if (outputFile == NULL || fwrite(data, 1, size, outputFile) != size)
+    {
+        fprintf(stderr, "%s: error: could not write the level file\n", outputName);
+        if (outputFile != NULL) fclose(outputFile);
+        free(data);
+        remove(outputName);
+        return 1;
+    }
+
+    fclose(outputFile);
+
+    printf("%s: %ix%i cells, %u tris, %u platfs, %u bytes\n", outputName, width, height, header->trisCount, header->platfsCount, size);
+
+    free(data);
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Local Functions Definition
+//----------------------------------------------------------------------------------
+
+// Xorshift32, the same level on every platform (rand() is not)
+static unsigned int GetRandom(unsigned int *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return *state;
+}
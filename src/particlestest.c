@@ -0,0 +1,209 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - particlestest (particles update stage threads tests)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Runs the same emitters (seeded streams, an arena budget that evicts particles) twice: with the
+*   update stage on the calling thread, and on the worker pool. The arena is big enough to go over
+*   PARTICLES_THREADED_MIN live particles, which the game arena never reaches. The live particles
+*   of every emitter are hashed after each update, and both runs must give the same hashes.
+*
+*   Usage: particlestest [-f frames] [-w workers] [-s seed]
+*
+*   Exit code: 0 the results match, 1 a frame differs (the first one is printed) or the workers
+*   never ran, 2 bad arguments
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "screens/particles.h"
+#include "screens/statehash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_FRAMES 600
+#define DEFAULT_WORKERS 4
+
+#define TEST_EMITTERS 3
+#define TEST_ARENA_SIZE (PARTICLES_THREADED_MIN*4) // Slots of all the emitters
+#define TEST_BUDGET (PARTICLES_THREADED_MIN*2) // Max live particles, under what the emitters spawn so spawning evicts
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct TestRun
+{
+    unsigned long long *hashes; // One per frame
+    int maxActiveCount; // Max arena live particles after an update
+    int workersCount; // Worker threads that were running at the end
+} TestRun;
+
+//----------------------------------------------------------------------------------
+// Local Functions Declaration
+//----------------------------------------------------------------------------------
+static void InitTestEmitter(ParticleEmitter *pE, ParticleArena *arena, int index, unsigned int seed);
+static unsigned long long HashParticles(Particles *particles, unsigned long long hash);
+static void RunParticles(TestRun *run, int framesCount, int workersCount, unsigned int seed);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int framesCount = DEFAULT_FRAMES;
+    int workersCount = DEFAULT_WORKERS;
+    unsigned int seed = 1;
+
+    TestRun singleRun;
+    TestRun threadedRun;
+    int result = 0;
+
+    for (int i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) framesCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) workersCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = strtoul(argv[++i], NULL, 10);
+        else framesCount = 0;
+    }
+
+    if (framesCount <= 0 || workersCount <= 0 || workersCount > PARTICLES_MAX_WORKERS)
+    {
+        fprintf(stderr, "Usage: particlestest [-f frames] [-w workers] [-s seed]\n");
+        fprintf(stderr, "       workers from 1 to %i\n", PARTICLES_MAX_WORKERS);
+        return 2;
+    }
+
+    singleRun.hashes = malloc(sizeof(unsigned long long)*framesCount);
+    threadedRun.hashes = malloc(sizeof(unsigned long long)*framesCount);
+
+    RunParticles(&singleRun, framesCount, 0, seed);
+    RunParticles(&threadedRun, framesCount, workersCount, seed);
+
+    if (threadedRun.maxActiveCount < PARTICLES_THREADED_MIN || threadedRun.workersCount == 0)
+    {
+        fprintf(stderr, "particlestest: error: the workers never ran (%i live particles at most, %i workers, PARTICLES_NO_THREADS build?)\n", threadedRun.maxActiveCount, threadedRun.workersCount);
+        result = 1;
+    }
+
+    for (int i=0; i<framesCount && result == 0; i++)
+    {
+        if (singleRun.hashes[i] != threadedRun.hashes[i])
+        {
+            fprintf(stderr, "particlestest: error: frame %i differs, single thread %016llx, %i workers %016llx (seed %u)\n",
+                    i, singleRun.hashes[i], workersCount, threadedRun.hashes[i], seed);
+            result = 1;
+        }
+    }
+
+    if (result == 0) printf("particlestest: %i frames (up to %i live particles, %i workers), all the results match\n", framesCount, threadedRun.maxActiveCount, threadedRun.workersCount);
+
+    free(singleRun.hashes);
+    free(threadedRun.hashes);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Local Functions Definition
+//----------------------------------------------------------------------------------
+
+// Emitters spawn more than the budget allows (the later ones have higher priority, so they evict the first ones)
+static void InitTestEmitter(ParticleEmitter *pE, ParticleArena *arena, int index, unsigned int seed)
+{
+    memset(pE, 0, sizeof(ParticleEmitter));
+
+    pE->spawnRadius = 20 + 10*index;
+    pE->gravity.direction = (Vector2){ 0, 1 };
+    pE->gravity.value = 0.1f*index;
+    pE->gravity.force = (Vector2){ 0, pE->gravity.value };
+    pE->ppf = 90 + 40*index + 0.5f;
+    pE->source.rotation[1] = 360;
+    pE->source.scale[0] = 0.5f;
+    pE->source.scale[1] = 2;
+    pE->source.direction[0] = (Vector2){ -1, -1 };
+    pE->source.direction[1] = (Vector2){ 1, 1 };
+    pE->source.movementSpeed[0] = (Vector2){ 1, 1 };
+    pE->source.movementSpeed[1] = (Vector2){ 6, 4 };
+    pE->source.rotationSpeed[0] = -5;
+    pE->source.rotationSpeed[1] = 5;
+    pE->source.scaleSpeed[0] = -0.02f;
+    pE->source.scaleSpeed[1] = 0.01f;
+    pE->source.lifeTime[0] = 30 + 20*index;
+    pE->source.lifeTime[1] = 120 + 40*index;
+    pE->isActive = true;
+
+    InitParticles(&pE->particles, arena, TEST_ARENA_SIZE/TEST_EMITTERS, index);
+    SetParticlesSeed(&pE->particles, seed*TEST_EMITTERS + index);
+}
+
+// Every property of the live particles (they are packed, so slots order is part of the result)
+static unsigned long long HashParticles(Particles *particles, unsigned long long hash)
+{
+    int size = sizeof(float)*particles->activeCount;
+
+    hash = HashStateData(hash, &particles->activeCount, sizeof(int));
+    hash = HashStateData(hash, particles->positionX, size);
+    hash = HashStateData(hash, particles->positionY, size);
+    hash = HashStateData(hash, particles->velocityX, size);
+    hash = HashStateData(hash, particles->velocityY, size);
+    hash = HashStateData(hash, particles->rotation, size);
+    hash = HashStateData(hash, particles->rotationSpeed, size);
+    hash = HashStateData(hash, particles->scale, size);
+    hash = HashStateData(hash, particles->scaleSpeed, size);
+    hash = HashStateData(hash, particles->lifeTime, size);
+
+    return hash;
+}
+
+// Same emitters and seed on every run, workersCount 0 keeps the update stage on this thread
+static void RunParticles(TestRun *run, int framesCount, int workersCount, unsigned int seed)
+{
+    ParticleArena arena;
+    ParticleEmitter emitters[TEST_EMITTERS];
+
+    InitParticleArena(&arena, TEST_ARENA_SIZE, TEST_BUDGET);
+    for (int i=0; i<TEST_EMITTERS; i++) InitTestEmitter(&emitters[i], &arena, i, seed);
+
+    InitParticleWorkers(workersCount);
+
+    run->maxActiveCount = 0;
+
+    for (int frame=0; frame<framesCount; frame++)
+    {
+        unsigned long long hash = STATE_HASH_BASIS;
+
+        // Emitters move, so particles of different frames don't overlap
+        for (int i=0; i<TEST_EMITTERS; i++) UpdateParticleEmitter(&emitters[i], (Vector2){ frame*(i + 1), 100*i });
+
+        UpdateParticleArena(&arena);
+
+        for (int i=0; i<TEST_EMITTERS; i++) hash = HashParticles(&emitters[i].particles, hash);
+
+        run->hashes[frame] = hash;
+        if (arena.activeCount > run->maxActiveCount) run->maxActiveCount = arena.activeCount;
+    }
+
+    run->workersCount = GetParticleWorkersCount();
+
+    CloseParticleWorkers();
+    UnloadParticleArena(&arena);
+}
@@ -0,0 +1,135 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - raylib_headless (raylib replacement for the headless simulation)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Implements the raylib (and rlgl) functions used by the gameplay screen without window, GPU or
+*   audio device: drawing and audio do nothing, textures and sounds are never loaded (empty ones are
+*   returned) and keys are never pressed (scripted keys are pushed to the input module instead).
+*   Functions that the simulation results depend on (screen size, collisions, colors, text format)
+*   behave as raylib ones.
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "rlgl.h" // rlgl functions used by the particles (see particles.c)
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+// NOTE: Must match the TapToJAmp_v2_0.c window, level objects culling depends on it
+#define HEADLESS_SCREEN_WIDTH 1024
+#define HEADLESS_SCREEN_HEIGHT 576
+
+#define MAX_FORMATTEXT_LENGTH 64 // Same as raylib
+
+//----------------------------------------------------------------------------------
+// Window and Input Functions Definition
+//----------------------------------------------------------------------------------
+int GetScreenWidth(void) { return HEADLESS_SCREEN_WIDTH; }
+int GetScreenHeight(void) { return HEADLESS_SCREEN_HEIGHT; }
+
+bool IsKeyPressed(int key) { return false; }
+bool IsKeyDown(int key) { return false; }
+
+//----------------------------------------------------------------------------------
+// Drawing Functions Definition
+//----------------------------------------------------------------------------------
+void DrawRectangle(int posX, int posY, int width, int height, Color color) { }
+void DrawRectangleRec(Rectangle rec, Color color) { }
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color) { }
+void DrawTexture(Texture2D texture, int posX, int posY, Color tint) { }
+void DrawTextureV(Texture2D texture, Vector2 position, Color tint) { }
+void DrawTexturePro(Texture2D texture, Rectangle sourceRec, Rectangle destRec, Vector2 origin, float rotation, Color tint) { }
+
+void rlEnableTexture(unsigned int id) { }
+void rlDisableTexture(void) { }
+void rlBegin(int mode) { }
+void rlEnd(void) { }
+void rlVertex2f(float x, float y) { }
+void rlTexCoord2f(float x, float y) { }
+void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a) { }
+void rlglDraw(void) { }
+
+//----------------------------------------------------------------------------------
+// Image and Texture Functions Definition
+//----------------------------------------------------------------------------------
+Image LoadImage(const char *fileName) { return (Image){ 0 }; }
+Image LoadImageEx(Color *pixels, int width, int height) { return (Image){ 0 }; }
+Image LoadImageRaw(const char *fileName, int width, int height, int format, int headerSize) { return (Image){ 0 }; }
+Image ImageText(const char *text, int fontSize, Color color) { return (Image){ 0 }; }
+void UnloadImage(Image image) { free(image.data); }
+Color *GetImageData(Image image) { return NULL; }
+
+Texture2D LoadTexture(const char *fileName) { return (Texture2D){ 0 }; }
+Texture2D LoadTextureFromImage(Image image) { return (Texture2D){ 0 }; }
+void UnloadTexture(Texture2D texture) { }
+void UpdateTexture(Texture2D texture, void *pixels) { }
+
+//----------------------------------------------------------------------------------
+// Audio Functions Definition
+//----------------------------------------------------------------------------------
+Sound LoadSound(char *fileName) { return (Sound){ 0 }; }
+void UnloadSound(Sound sound) { }
+void PlaySound(Sound sound) { }
+void SetSoundVolume(Sound sound, float volume) { }
+
+void PlayMusicStream(char *fileName) { }
+void UpdateMusicStream(void) { }
+void StopMusicStream(void) { }
+void PauseMusicStream(void) { }
+void ResumeMusicStream(void) { }
+void SetMusicVolume(float volume) { }
+
+//----------------------------------------------------------------------------------
+// Simulation Functions Definition (same results as raylib)
+//----------------------------------------------------------------------------------
+bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2)
+{
+    bool collision = false;
+
+    int dx = abs((rec1.x + rec1.width/2) - (rec2.x + rec2.width/2));
+    int dy = abs((rec1.y + rec1.height/2) - (rec2.y + rec2.height/2));
+
+    if ((dx <= (rec1.width/2 + rec2.width/2)) && ((dy <= (rec1.height/2 + rec2.height/2)))) collision = true;
+
+    return collision;
+}
+
+Color Fade(Color color, float alpha)
+{
+    if (alpha < 0.0f) alpha = 0.0f;
+    else if (alpha > 1.0f) alpha = 1.0f;
+
+    return (Color){ color.r, color.g, color.b, (unsigned char)(color.a*alpha) };
+}
+
+const char *FormatText(const char *text, ...)
+{
+    static char buffer[MAX_FORMATTEXT_LENGTH];
+    va_list args;
+
+    va_start(args, text);
+    vsnprintf(buffer, MAX_FORMATTEXT_LENGTH, text, args);
+    va_end(args);
+
+    return buffer;
+}
@@ -0,0 +1,276 @@
+/*******************************************************************************************
+*
+*   Tap To JAmp - sattest (SAT batch collisions tests)
+*
+*   Developed by Marc Montagut - @MarcMDE
+*
+*   Tests the batch collisions (SATPolyTrisBatchCollide, SATPolyAABoxesBatchCollide) against the
+*   scalar SAT (SATPolysCollide) with random players and colliders: axis aligned players (the batch
+*   fast path), rotated ones (full SAT), grid aligned colliders (touching edges) and random ones.
+*   Every collider result and the returned collisions count must be the same. Linked with the game
+*   satcollision.o, so it tests the compiled SIMD path (make SATFLAGS=... to test others).
+*
+*   Usage: sattest [-n tests] [-s seed]
+*
+*   Exit code: 0 all the results match, 1 a result differs (the first test that fails is printed), 2 bad arguments
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "screens/satcollision.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// NOTE: Must match screen_gameplay.c
+#define CELL_SIZE 48
+
+#define DEFAULT_TESTS 20000
+#define MAX_BATCH_COLLIDERS 64 // Colliders per batch (random count up to it, odd counts test the SIMD tails)
+#define TEST_AREA (CELL_SIZE*4) // Colliders are placed around the player, on a square of this size
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition (local to this module)
+//----------------------------------------------------------------------------------
+static unsigned int randomState;
+
+//----------------------------------------------------------------------------------
+// Local Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetRandom(void);
+static float GetRandomRange(float min, float max);
+static Vector2 GetRandomPosition(Vector2 center, bool isOnGrid);
+static void InitRandomPlayer(SATBox *player);
+static int TestTrisBatch(int test);
+static int TestAABoxesBatch(int test);
+static void PrintPoints(const char *name, Vector2 *points, int lenght);
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int testsCount = DEFAULT_TESTS;
+    unsigned int seed = 1;
+    int collisions = 0;
+
+    for (int i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) testsCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = strtoul(argv[++i], NULL, 10);
+        else testsCount = -1;
+    }
+
+    if (testsCount < 0)
+    {
+        fprintf(stderr, "Usage: sattest [-n tests] [-s seed]\n");
+        return 2;
+    }
+
+    randomState = (seed != 0) ? seed : 1;
+
+    for (int i=0; i<testsCount; i++)
+    {
+        int trisCollisions = TestTrisBatch(i);
+        int boxesCollisions = (trisCollisions >= 0) ? TestAABoxesBatch(i) : -1;
+
+        if (trisCollisions < 0 || boxesCollisions < 0)
+        {
+            fprintf(stderr, "sattest: error: test %i of %i failed (seed %u)\n", i, testsCount, seed);
+            return 1;
+        }
+
+        collisions += trisCollisions + boxesCollisions;
+    }
+
+    printf("sattest: %i tests (tris and boxes batches), %i collisions, all the results match\n", testsCount, collisions);
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Local Functions Definition
+//----------------------------------------------------------------------------------
+
+// Xorshift32, the same sequence on every platform (rand() is not)
+static unsigned int GetRandom(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    return randomState;
+}
+
+static float GetRandomRange(float min, float max)
+{
+    return min + (max - min)*(GetRandom()%1000000)/1000000.0f;
+}
+
+// Grid positions are cell centers (colliders touch the ones next to them), the others are anywhere
+static Vector2 GetRandomPosition(Vector2 center, bool isOnGrid)
+{
+    Vector2 position = { GetRandomRange(center.x - TEST_AREA/2, center.x + TEST_AREA/2), GetRandomRange(center.y - TEST_AREA/2, center.y + TEST_AREA/2) };
+
+    if (isOnGrid)
+    {
+        position.x = floorf(position.x/CELL_SIZE)*CELL_SIZE + CELL_SIZE/2;
+        position.y = floorf(position.y/CELL_SIZE)*CELL_SIZE + CELL_SIZE/2;
+    }
+
+    return position;
+}
+
+// Half of the players are axis aligned (some of them on the grid, as the gameplay one), the others rotated
+static void InitRandomPlayer(SATBox *player)
+{
+    int type = GetRandom()%4;
+    float rotation = 0;
+
+    if (type == 2) rotation = (GetRandom()%4)*90; // Quarter turns are still axis aligned
+    else if (type == 3) rotation = GetRandomRange(0, 360);
+
+    InitSATBox(player, GetRandomPosition((Vector2){ 0, 0 }, type == 0), (Vector2){ CELL_SIZE, CELL_SIZE }, rotation);
+}
+
+// Returns the collisions, -1 if a batch result differs from the scalar one
+static int TestTrisBatch(int test)
+{
+    SATBox player;
+    SATTri tris[MAX_BATCH_COLLIDERS];
+    float trisData[6][MAX_BATCH_COLLIDERS];
+    SATTriBatch batch = { { trisData[0], trisData[1], trisData[2] }, { trisData[3], trisData[4], trisData[5] }, 0 };
+    Vector2 normals[3];
+    unsigned char results[MAX_BATCH_COLLIDERS];
+    bool isOnGrid = GetRandom()%2;
+    Vector2 size = { CELL_SIZE, CELL_SIZE };
+    int collisions;
+    int scalarCollisions = 0;
+
+    InitRandomPlayer(&player);
+
+    // All the tris of a batch share the size (same normals), half of the tests use the gameplay one
+    if (!isOnGrid) size = (Vector2){ GetRandomRange(8, CELL_SIZE*2), GetRandomRange(8, CELL_SIZE*2) };
+
+    batch.count = 1 + GetRandom()%MAX_BATCH_COLLIDERS;
+
+    for (int i=0; i<batch.count; i++)
+    {
+        InitSATTri(&tris[i], GetRandomPosition(player.position, isOnGrid), size, 0);
+
+        for (int j=0; j<3; j++)
+        {
+            batch.x[j][i] = tris[i].points[j].x;
+            batch.y[j][i] = tris[i].points[j].y;
+        }
+    }
+
+    SetNormals(tris[0].points, normals, 3, true);
+
+    collisions = SATPolyTrisBatchCollide(player.points, 4, batch, normals, results);
+
+    for (int i=0; i<batch.count; i++)
+    {
+        bool isColliding = SATPolysCollide(player.points, 4, tris[i].points, 3);
+
+        if (isColliding != (results[i] != 0))
+        {
+            printf("test %i: tri %i of %i, batch result %i, scalar result %i\n", test, i, batch.count, results[i], isColliding);
+            PrintPoints("player", player.points, 4);
+            PrintPoints("tri", tris[i].points, 3);
+            return -1;
+        }
+
+        scalarCollisions += isColliding;
+    }
+
+    if (collisions != scalarCollisions)
+    {
+        printf("test %i: tris batch returned %i collisions, scalar ones are %i\n", test, collisions, scalarCollisions);
+        return -1;
+    }
+
+    return collisions;
+}
+
+// Returns the collisions, -1 if a batch result differs from the scalar one
+static int TestAABoxesBatch(int test)
+{
+    SATBox player;
+    SATBox boxes[MAX_BATCH_COLLIDERS];
+    float boxesData[4][MAX_BATCH_COLLIDERS];
+    SATAABoxBatch batch = { boxesData[0], boxesData[1], boxesData[2], boxesData[3], 0 };
+    unsigned char results[MAX_BATCH_COLLIDERS];
+    bool isOnGrid = GetRandom()%2;
+    int collisions;
+    int scalarCollisions = 0;
+
+    InitRandomPlayer(&player);
+
+    batch.count = 1 + GetRandom()%MAX_BATCH_COLLIDERS;
+
+    for (int i=0; i<batch.count; i++)
+    {
+        // Platform spans: whole cells on the grid (up to 8 cells wide), any size out of it
+        Vector2 size = { CELL_SIZE*(1 + GetRandom()%8), CELL_SIZE*(1 + GetRandom()%3) };
+
+        if (!isOnGrid) size = (Vector2){ GetRandomRange(8, CELL_SIZE*4), GetRandomRange(8, CELL_SIZE*4) };
+
+        InitSATBox(&boxes[i], GetRandomPosition(player.position, isOnGrid), size, 0);
+
+        batch.minX[i] = fminf(fminf(boxes[i].points[0].x, boxes[i].points[1].x), fminf(boxes[i].points[2].x, boxes[i].points[3].x));
+        batch.minY[i] = fminf(fminf(boxes[i].points[0].y, boxes[i].points[1].y), fminf(boxes[i].points[2].y, boxes[i].points[3].y));
+        batch.maxX[i] = fmaxf(fmaxf(boxes[i].points[0].x, boxes[i].points[1].x), fmaxf(boxes[i].points[2].x, boxes[i].points[3].x));
+        batch.maxY[i] = fmaxf(fmaxf(boxes[i].points[0].y, boxes[i].points[1].y), fmaxf(boxes[i].points[2].y, boxes[i].points[3].y));
+    }
+
+    collisions = SATPolyAABoxesBatchCollide(player.points, 4, batch, results);
+
+    for (int i=0; i<batch.count; i++)
+    {
+        bool isColliding = SATPolysCollide(player.points, 4, boxes[i].points, 4);
+
+        if (isColliding != (results[i] != 0))
+        {
+            printf("test %i: box %i of %i, batch result %i, scalar result %i\n", test, i, batch.count, results[i], isColliding);
+            PrintPoints("player", player.points, 4);
+            PrintPoints("box", boxes[i].points, 4);
+            return -1;
+        }
+
+        scalarCollisions += isColliding;
+    }
+
+    if (collisions != scalarCollisions)
+    {
+        printf("test %i: boxes batch returned %i collisions, scalar ones are %i\n", test, collisions, scalarCollisions);
+        return -1;
+    }
+
+    return collisions;
+}
+
+static void PrintPoints(const char *name, Vector2 *points, int lenght)
+{
+    printf("  %s:", name);
+    for (int i=0; i<lenght; i++) printf(" (%.9g, %.9g)", points[i].x, points[i].y);
+    printf("\n");
+}
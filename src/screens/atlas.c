@@ -0,0 +1,127 @@
+/*
+*   atlas.c
+*
+*   Tap To JAmp sprites atlas format. Made by Marc Montagut - @MarcMDE
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#include "atlas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//----------------------------------------------------------------------------------
+static bool ReadAtlasHeader (FILE *file, AtlasHeader *header);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Reads the header and the rects table, pixels are loaded by raylib as a raw image (header skipped)
+bool LoadAtlas (Atlas *atlas, const char *fileName)
+{
+    AtlasHeader header;
+    FILE *file;
+    Image image;
+    bool isValid = false;
+
+    memset(atlas, 0, sizeof(Atlas));
+
+    file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+
+    if (ReadAtlasHeader(file, &header))
+    {
+        atlas->rects = malloc(sizeof(AtlasRect)*header.rectsCount); // Remember to free
+
+        if (atlas->rects != NULL && fread(atlas->rects, sizeof(AtlasRect), header.rectsCount, file) == header.rectsCount)
+        {
+            atlas->rectsCount = header.rectsCount;
+            isValid = true;
+        }
+    }
+
+    fclose(file);
+
+    if (isValid)
+    {
+        image = LoadImageRaw(fileName, header.width, header.height, UNCOMPRESSED_R8G8B8A8, sizeof(AtlasHeader) + sizeof(AtlasRect)*header.rectsCount);
+
+        if (image.data != NULL)
+        {
+            atlas->texture = LoadTextureFromImage(image);
+            UnloadImage(image);
+        }
+        else isValid = false;
+    }
+
+    if (!isValid) UnloadAtlas(atlas);
+
+    return isValid;
+}
+
+void UnloadAtlas (Atlas *atlas)
+{
+    if (atlas->texture.id != 0) UnloadTexture(atlas->texture);
+    free(atlas->rects);
+
+    memset(atlas, 0, sizeof(Atlas));
+}
+
+// Loads the atlas pixels on CPU memory (to compose images with the sprites), image.data is NULL on failure
+Image LoadAtlasImage (const char *fileName)
+{
+    AtlasHeader header;
+    Image image = { 0 };
+    FILE *file = fopen(fileName, "rb");
+
+    if (file == NULL) return image;
+
+    if (ReadAtlasHeader(file, &header))
+    {
+        fclose(file);
+        image = LoadImageRaw(fileName, header.width, header.height, UNCOMPRESSED_R8G8B8A8, sizeof(AtlasHeader) + sizeof(AtlasRect)*header.rectsCount);
+    }
+    else fclose(file);
+
+    return image;
+}
+
+Rectangle GetAtlasRec (Atlas *atlas, const char *name)
+{
+    for (int i=0; i<atlas->rectsCount; i++)
+    {
+        if (strncmp(atlas->rects[i].name, name, ATLAS_NAME_LENGHT) == 0) return (Rectangle){ atlas->rects[i].x, atlas->rects[i].y, atlas->rects[i].width, atlas->rects[i].height };
+    }
+
+    return (Rectangle){ 0, 0, 0, 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+static bool ReadAtlasHeader (FILE *file, AtlasHeader *header)
+{
+    return (fread(header, sizeof(AtlasHeader), 1, file) == 1 && header->magic == ATLAS_FILE_MAGIC && header->version == ATLAS_FILE_VERSION &&
+            header->width > 0 && header->width <= ATLAS_MAX_SIZE && header->height > 0 && header->height <= ATLAS_MAX_SIZE);
+}
@@ -0,0 +1,87 @@
+/*
+*   atlas.h
+*
+*   Tap To JAmp sprites atlas format. Made by Marc Montagut - @MarcMDE
+*
+*   Gameplay sprites are packed at build time (atlasc tool) into a single texture, so all of them
+*   can be drawn on the same raylib batch. Layout (little endian, 4 bytes aligned):
+*
+*       AtlasHeader     header
+*       AtlasRect       rects[rectsCount]
+*       unsigned char   pixels[width*height*4] (RGBA, row major)
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "raylib.h"
+
+#define ATLAS_FILE_MAGIC 0x41544a54 // "TJTA"
+#define ATLAS_FILE_VERSION 1
+
+#define ATLAS_NAME_LENGHT 32 // Sprite name (file name without extension), including the '\0'
+#define ATLAS_MAX_SIZE 4096
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Structs
+// ---------------------------
+typedef struct AtlasHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int width;
+    unsigned int height;
+    unsigned int rectsCount;
+}AtlasHeader;
+
+typedef struct AtlasRect
+{
+    char name[ATLAS_NAME_LENGHT];
+    int x;
+    int y;
+    int width;
+    int height;
+}AtlasRect;
+
+typedef struct Atlas
+{
+    Texture2D texture;
+    AtlasRect *rects; // Remember to unload
+    int rectsCount;
+}Atlas;
+// ----------------------------
+
+// Functions
+// ----------------------------
+bool LoadAtlas (Atlas *atlas, const char *fileName); // Loads the atlas texture (one upload), returns false on failure
+void UnloadAtlas (Atlas *atlas);
+Image LoadAtlasImage (const char *fileName); // Loads the atlas pixels only (CPU), remember to unload
+Rectangle GetAtlasRec (Atlas *atlas, const char *name); // Sprite rectangle on the atlas texture (empty if not found)
+// ----------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ATLAS_H
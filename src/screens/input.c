@@ -0,0 +1,405 @@
+/*
+*   input.c
+*
+*   Tap To JAmp simulation input. Made by Marc Montagut - @MarcMDE
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#define _POSIX_C_SOURCE 200112L // clock_gettime()
+
+#include "input.h"
+#include <stdlib.h> // getenv()
+
+#if defined(PLATFORM_WEB)
+    #include <emscripten.h> // emscripten_get_now()
+#elif !defined(_WIN32)
+    #include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if defined(INPUT_EVDEV)
+    #include <pthread.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/ioctl.h>
+    #include <sys/time.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(INPUT_EVDEV)
+// Linux input values used to read the keyboard (linux/input.h is not included, its key names clash with raylib ones)
+#define EVDEV_KEY 1 // EV_KEY event type
+#define EVDEV_SET_CLOCK_ID _IOW('E', 0xa0, int) // EVIOCSCLOCKID, events time from CLOCK_MONOTONIC
+#define EVDEV_POLL_TIMEOUT 100 // Milliseconds, the keyboard thread checks if it has to quit at least this often
+#endif
+
+// Events ring indices shared by the producer and the consumer (acquire loads, release stores)
+#if defined(_MSC_VER)
+    #define LOAD_ACQUIRE(index) ((unsigned int)_InterlockedOr((volatile long *)(index), 0))
+    #define STORE_RELEASE(index, value) _InterlockedExchange((volatile long *)(index), (long)(value))
+#else
+    #define LOAD_ACQUIRE(index) __atomic_load_n(index, __ATOMIC_ACQUIRE)
+    #define STORE_RELEASE(index, value) __atomic_store_n(index, value, __ATOMIC_RELEASE)
+#endif
+
+#if defined(_WIN32)
+// Performance counter, declared here (windows.h names clash with raylib ones)
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *frequency);
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct KeyEvent
+{
+    double time; // GetInputTime() clock
+    int key; // Game key index
+    bool isDown;
+}KeyEvent;
+
+#if defined(INPUT_EVDEV)
+// struct input_event
+typedef struct EvdevEvent
+{
+    struct timeval time;
+    unsigned short type;
+    unsigned short code;
+    int value; // 0 released, 1 pressed, 2 repeated
+}EvdevEvent;
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition (local to this module)
+//----------------------------------------------------------------------------------
+static const int gameKeys[] = GAME_KEYS;
+
+#define GAME_KEYS_COUNT (int)(sizeof(gameKeys)/sizeof(gameKeys[0]))
+
+static bool keysPressed[GAME_KEYS_COUNT]; // Pressed since the last simulation step
+static bool keysDown[GAME_KEYS_COUNT];
+
+// Key events ring: written by one producer (keyboard thread or UpdateGameInput) and read by the simulation steps
+static KeyEvent events[INPUT_EVENTS_SIZE];
+static unsigned int eventsHead; // Next event to read (consumer)
+static unsigned int eventsTail; // Next event to write (producer)
+
+// Latest change of every key that didn't fit on the ring (-1 none, 0 up, 1 down), written by the producer only
+// NOTE: They are pushed as soon as there is room (and before any newer event), so a key release is never lost
+static signed char overflowKeys[GAME_KEYS_COUNT];
+static bool overflowPressedKeys[GAME_KEYS_COUNT]; // Key pressed while the ring was full, so a tap (press and release) keeps its press
+static double overflowTime;
+static bool isOverflowed;
+
+static bool sampledKeysDown[GAME_KEYS_COUNT]; // Keys down on the last frame sample
+static double lastSampleTime;
+
+#if defined(INPUT_EVDEV)
+static const unsigned short evdevKeys[GAME_KEYS_COUNT] = { 57, 28, 105, 106, 25, 19, 46 }; // GAME_KEYS Linux codes
+
+static pthread_t keyboardThread;
+static int keyboardFile = -1;
+static bool isKeyboardThreadActive;
+static volatile bool quitKeyboardThread;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//----------------------------------------------------------------------------------
+static int GetGameKeyIndex (int key);
+static void PushKeyEvent (double time, int key, bool isDown);
+static bool FlushOverflowKeys (void);
+#if defined(INPUT_EVDEV)
+static void *KeyboardThread (void *data);
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+void InitGameInput (void)
+{
+    lastSampleTime = GetInputTime();
+
+    for (int i=0; i<GAME_KEYS_COUNT; i++)
+    {
+        overflowKeys[i] = -1;
+        overflowPressedKeys[i] = false;
+    }
+
+    isOverflowed = false;
+
+#if defined(INPUT_EVDEV)
+    int clockId = CLOCK_MONOTONIC;
+    const char *deviceName = getenv(INPUT_EVDEV_DEVICE_ENV);
+
+    if (deviceName == NULL || deviceName[0] == '\0') deviceName = INPUT_EVDEV_DEVICE;
+
+    keyboardFile = open(deviceName, O_RDONLY | O_NONBLOCK);
+
+    if (keyboardFile >= 0)
+    {
+        quitKeyboardThread = false;
+
+        if (ioctl(keyboardFile, EVDEV_SET_CLOCK_ID, &clockId) == 0 && pthread_create(&keyboardThread, NULL, KeyboardThread, NULL) == 0) isKeyboardThreadActive = true;
+        else
+        {
+            close(keyboardFile);
+            keyboardFile = -1;
+        }
+    }
+#endif
+}
+
+void CloseGameInput (void)
+{
+#if defined(INPUT_EVDEV)
+    if (isKeyboardThreadActive)
+    {
+        quitKeyboardThread = true;
+        pthread_join(keyboardThread, NULL);
+        close(keyboardFile);
+
+        keyboardFile = -1;
+        isKeyboardThreadActive = false;
+    }
+#endif
+}
+
+double GetInputTime (void)
+{
+#if defined(PLATFORM_WEB)
+    return emscripten_get_now()/1000.0;
+#elif defined(_WIN32)
+    long long count, frequency;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+
+    return (double)count/frequency;
+#else
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec + time.tv_nsec/1000000000.0;
+#endif
+}
+
+// Pushes the key changes since the last sample, with the last sample time (the earliest they could happen)
+void UpdateGameInput (void)
+{
+    double time = GetInputTime();
+
+#if defined(INPUT_EVDEV)
+    if (isKeyboardThreadActive) return;
+#endif
+
+    FlushOverflowKeys();
+
+    for (int i=0; i<GAME_KEYS_COUNT; i++)
+    {
+        bool isDown = IsKeyDown(gameKeys[i]);
+
+        // A key pressed and released between samples is still pushed as a press
+        if (IsKeyPressed(gameKeys[i]) && !sampledKeysDown[i])
+        {
+            PushKeyEvent(lastSampleTime, i, true);
+            sampledKeysDown[i] = true;
+        }
+
+        if (isDown != sampledKeysDown[i])
+        {
+            PushKeyEvent(lastSampleTime, i, isDown);
+            sampledKeysDown[i] = isDown;
+        }
+    }
+
+    lastSampleTime = time;
+}
+
+void PushGameKeyEvent (double time, int key, bool isDown)
+{
+    int index = GetGameKeyIndex(key);
+
+    if (index >= 0) PushKeyEvent(time, index, isDown);
+}
+
+void BeginGameInputStep (double stepEndTime)
+{
+    unsigned int tail = LOAD_ACQUIRE(&eventsTail);
+
+    while (eventsHead != tail && events[eventsHead%INPUT_EVENTS_SIZE].time <= stepEndTime)
+    {
+        KeyEvent *event = &events[eventsHead%INPUT_EVENTS_SIZE];
+
+        if (event->isDown && !keysDown[event->key]) keysPressed[event->key] = true;
+        keysDown[event->key] = event->isDown;
+
+        STORE_RELEASE(&eventsHead, eventsHead + 1);
+    }
+}
+
+unsigned short GetGameInputState (void)
+{
+    unsigned short state = 0;
+
+    for (int i=0; i<GAME_KEYS_COUNT; i++)
+    {
+        if (keysDown[i]) state |= 1 << i;
+        if (keysPressed[i]) state |= 1 << (i + 8);
+    }
+
+    return state;
+}
+
+void SetGameInputState (unsigned short state)
+{
+    for (int i=0; i<GAME_KEYS_COUNT; i++)
+    {
+        keysDown[i] = (state & (1 << i)) != 0;
+        keysPressed[i] = (state & (1 << (i + 8))) != 0;
+    }
+}
+
+void EndGameInputStep (void)
+{
+    for (int i=0; i<GAME_KEYS_COUNT; i++) keysPressed[i] = false;
+}
+
+bool IsGameKeyPressed (int key)
+{
+    int index = GetGameKeyIndex(key);
+
+    return (index >= 0) ? keysPressed[index] : false;
+}
+
+// NOTE: A key pressed and released on the same step is down for that step
+bool IsGameKeyDown (int key)
+{
+    int index = GetGameKeyIndex(key);
+
+    return (index >= 0) ? (keysDown[index] || keysPressed[index]) : false;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+static int GetGameKeyIndex (int key)
+{
+    for (int i=0; i<GAME_KEYS_COUNT; i++)
+    {
+        if (gameKeys[i] == key) return i;
+    }
+
+    return -1;
+}
+
+// Single producer push: the event is written before the tail is published
+// NOTE: While the ring is full, only the latest change of every key is kept (pushed later by FlushOverflowKeys)
+static void PushKeyEvent (double time, int key, bool isDown)
+{
+    unsigned int head = LOAD_ACQUIRE(&eventsHead);
+
+    if ((isOverflowed && !FlushOverflowKeys()) || eventsTail - head >= INPUT_EVENTS_SIZE)
+    {
+        overflowKeys[key] = isDown;
+        if (isDown) overflowPressedKeys[key] = true;
+        overflowTime = time;
+        isOverflowed = true;
+        return;
+    }
+
+    events[eventsTail%INPUT_EVENTS_SIZE] = (KeyEvent){ time, key, isDown };
+
+    STORE_RELEASE(&eventsTail, eventsTail + 1);
+}
+
+// Pushes the kept key changes that fit on the ring, returns true if all of them were pushed
+// NOTE: A key pressed and released while the ring was full is pushed as a press and then a release
+static bool FlushOverflowKeys (void)
+{
+    unsigned int head = LOAD_ACQUIRE(&eventsHead);
+
+    if (!isOverflowed) return true;
+
+    for (int i=0; i<GAME_KEYS_COUNT; i++)
+    {
+        if (overflowKeys[i] >= 0)
+        {
+            if (overflowKeys[i] == 0 && overflowPressedKeys[i])
+            {
+                if (eventsTail - head >= INPUT_EVENTS_SIZE) return false;
+
+                events[eventsTail%INPUT_EVENTS_SIZE] = (KeyEvent){ overflowTime, i, true };
+                STORE_RELEASE(&eventsTail, eventsTail + 1);
+
+                overflowPressedKeys[i] = false;
+            }
+
+            if (eventsTail - head >= INPUT_EVENTS_SIZE) return false;
+
+            events[eventsTail%INPUT_EVENTS_SIZE] = (KeyEvent){ overflowTime, i, overflowKeys[i] == 1 };
+            STORE_RELEASE(&eventsTail, eventsTail + 1);
+
+            overflowKeys[i] = -1;
+            overflowPressedKeys[i] = false;
+        }
+    }
+
+    isOverflowed = false;
+
+    return true;
+}
+
+#if defined(INPUT_EVDEV)
+// Reads the keyboard events as soon as the kernel delivers them (independent of the drawn frames)
+static void *KeyboardThread (void *data)
+{
+    struct pollfd keyboardPoll = { keyboardFile, POLLIN, 0 };
+    EvdevEvent evdevEvent;
+
+    while (!quitKeyboardThread)
+    {
+        FlushOverflowKeys(); // Also when there are no new events, so the kept ones are not delayed until the next one
+
+        if (poll(&keyboardPoll, 1, EVDEV_POLL_TIMEOUT) <= 0) continue;
+
+        while (read(keyboardFile, &evdevEvent, sizeof(EvdevEvent)) == sizeof(EvdevEvent))
+        {
+            if (evdevEvent.type != EVDEV_KEY || evdevEvent.value == 2) continue;
+
+            for (int i=0; i<GAME_KEYS_COUNT; i++)
+            {
+                if (evdevKeys[i] == evdevEvent.code) PushKeyEvent(evdevEvent.time.tv_sec + evdevEvent.time.tv_usec/1000000.0, i, evdevEvent.value == 1);
+            }
+        }
+    }
+
+    return NULL;
+}
+#endif
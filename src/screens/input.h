@@ -0,0 +1,71 @@
+/*
+*   input.h
+*
+*   Tap To JAmp simulation input. Made by Marc Montagut - @MarcMDE
+*
+*   The game logic runs on fixed simulation steps, so a drawn frame can run zero, one or more steps.
+*   Key changes are queued as timestamped events (lock-free single producer ring) and every simulation step
+*   applies the events that happened until its end time, so a key press starts on the step it happened on
+*   (not on the first step after the next drawn frame), it is never missed and never repeated.
+*
+*   Events are pushed by a thread reading the keyboard device (evdev, kernel timestamps) when compiled
+*   with INPUT_EVDEV (Linux), otherwise keys are sampled with raylib once per drawn frame (UpdateGameInput).
+*   Only the game keys (GAME_KEYS) are tracked.
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "raylib.h"
+
+// Keys used by the screens (any other key is never pressed or down)
+#define GAME_KEYS { KEY_SPACE, KEY_ENTER, KEY_LEFT, KEY_RIGHT, 'P', 'R', 'C' }
+#define INPUT_EVENTS_SIZE 64 // Queued key events (power of 2), only the latest change of every key is kept while it is full
+
+#if !defined(INPUT_EVDEV_DEVICE)
+    #define INPUT_EVDEV_DEVICE "/dev/input/event0" // Keyboard device read with INPUT_EVDEV (needs read permission)
+#endif
+#define INPUT_EVDEV_DEVICE_ENV "TAPTOJAMP_KEYBOARD" // Environment variable that overrides INPUT_EVDEV_DEVICE (e.g. /dev/input/by-id/...-event-kbd)
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Functions
+// ----------------------------
+void InitGameInput (void); // Starts the keyboard thread (INPUT_EVDEV), keys are sampled per frame if it fails
+void CloseGameInput (void);
+double GetInputTime (void); // Monotonic time (seconds) of the key events
+void UpdateGameInput (void); // Samples the game keys (if there is no keyboard thread), call once per drawn frame
+void PushGameKeyEvent (double time, int key, bool isDown); // Queues a key change (scripted input, don't mix with UpdateGameInput)
+void BeginGameInputStep (double stepEndTime); // Applies the key events until the step end time, call before every step
+unsigned short GetGameInputState (void); // Keys read by the current step (GAME_KEYS order bits: down keys, pressed keys << 8), recorded on replays
+void SetGameInputState (unsigned short state); // Replaces the keys of the current step (replays), call instead of BeginGameInputStep
+void EndGameInputStep (void); // Clears the key presses read by the simulation step, call after every step
+bool IsGameKeyPressed (int key); // Key pressed since the last simulation step
+bool IsGameKeyDown (int key); // Key down (or pressed and released since the last simulation step)
+// ----------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INPUT_H
@@ -0,0 +1,299 @@
+/*
+*   level.c
+*
+*   Tap To JAmp runtime level format. Made by Marc Montagut - @MarcMDE
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200112L // mmap(), fstat()
+#endif
+
+#include "level.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//----------------------------------------------------------------------------------
+static int SetLevelPointers (Level *level);
+static void *MapFile (const char *fileName, unsigned int *size);
+static void UnmapFile (void *data, unsigned int size);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+int LoadLevel (Level *level, const char *fileName)
+{
+    memset(level, 0, sizeof(Level));
+
+    level->data = MapFile(fileName, &level->size);
+    if (level->data == NULL) return 0;
+    level->isMapped = 1;
+
+    if (!SetLevelPointers(level))
+    {
+        UnloadLevel(level);
+        return 0;
+    }
+
+    return 1;
+}
+
+int LoadLevelFromPixels (Level *level, const unsigned char *pixels, int width, int height)
+{
+    memset(level, 0, sizeof(Level));
+
+    level->data = CompileLevel(pixels, width, height, &level->size);
+    if (level->data == NULL) return 0;
+    level->isMapped = 0;
+
+    if (!SetLevelPointers(level))
+    {
+        UnloadLevel(level);
+        return 0;
+    }
+
+    return 1;
+}
+
+void UnloadLevel (Level *level)
+{
+    if (level->data != NULL)
+    {
+        if (level->isMapped) UnmapFile(level->data, level->size);
+        else free(level->data);
+    }
+
+    memset(level, 0, sizeof(Level));
+}
+
+int GetLevelCellType (const unsigned char *pixel)
+{
+    if (pixel[0] == 255 && pixel[1] == 0 && pixel[2] == 0 && pixel[3] == 255) return LEVEL_CELL_TRI;
+    else if (pixel[0] == 0 && pixel[1] == 255 && pixel[2] == 0 && pixel[3] == 255) return LEVEL_CELL_PLATF;
+
+    return LEVEL_CELL_EMPTY;
+}
+
+// NOTE: 64-bit, file headers counts can be up to 0xffffffff each
+unsigned long long GetLevelDataSize (unsigned int width, unsigned int trisCount, unsigned int platfsCount)
+{
+    return sizeof(LevelHeader) + 2ULL*sizeof(unsigned int)*(width + 1ULL) + sizeof(LevelCell)*((unsigned long long)trisCount + platfsCount);
+}
+
+unsigned long long GetLevelHash (const Level *level)
+{
+    const unsigned char *data = level->data;
+    unsigned long long hash = 0xcbf29ce484222325ULL; // FNV-1a 64 offset basis
+
+    for (unsigned int i=0; i<level->size; i++)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL; // FNV-1a 64 prime
+    }
+
+    return hash;
+}
+
+// Classifies the map pixels (row major, RGBA) and packs the occupied cells sorted by column.
+void *CompileLevel (const unsigned char *pixels, int width, int height, unsigned int *size)
+{
+    LevelHeader header;
+    unsigned char *data;
+    unsigned int *trisColumnOffset;
+    unsigned int *platfsColumnOffset;
+    LevelCell *tris;
+    LevelCell *platfs;
+
+    int trisCounter = 0;
+    int platfsCounter = 0;
+
+    if (width <= 0 || height <= 0 || width > LEVEL_MAX_WIDTH || height > LEVEL_MAX_HEIGHT) return NULL;
+
+    header.magic = LEVEL_FILE_MAGIC;
+    header.version = LEVEL_FILE_VERSION;
+    header.width = width;
+    header.height = height;
+    header.trisCount = 0;
+    header.platfsCount = 0;
+
+    for (int i=0; i<width*height; i++)
+    {
+        int type = GetLevelCellType(&pixels[i*4]);
+
+        if (type == LEVEL_CELL_TRI) header.trisCount++;
+        else if (type == LEVEL_CELL_PLATF) header.platfsCount++;
+    }
+
+    *size = (unsigned int)GetLevelDataSize(header.width, header.trisCount, header.platfsCount); // Fits: up to LEVEL_MAX_WIDTH*LEVEL_MAX_HEIGHT cells
+    data = malloc(*size); // Remember to free
+    if (data == NULL) return NULL;
+
+    memcpy(data, &header, sizeof(LevelHeader));
+    trisColumnOffset = (unsigned int *)(data + sizeof(LevelHeader));
+    platfsColumnOffset = trisColumnOffset + (width + 1);
+    tris = (LevelCell *)(platfsColumnOffset + (width + 1));
+    platfs = tris + header.trisCount;
+
+    for (int x=0; x<width; x++)
+    {
+        trisColumnOffset[x] = trisCounter;
+        platfsColumnOffset[x] = platfsCounter;
+
+        for (int y=0; y<height; y++)
+        {
+            int type = GetLevelCellType(&pixels[(y*width + x)*4]);
+
+            if (type == LEVEL_CELL_TRI) tris[trisCounter++] = (LevelCell){ x, y, type };
+            else if (type == LEVEL_CELL_PLATF) platfs[platfsCounter++] = (LevelCell){ x, y, type };
+        }
+    }
+
+    trisColumnOffset[width] = trisCounter;
+    platfsColumnOffset[width] = platfsCounter;
+
+    return data;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Points the level sections into the data and checks they are consistent.
+// NOTE: Cells are checked too (O(columns + cells)): the game indexes per column buffers with them.
+static int SetLevelPointers (Level *level)
+{
+    const unsigned char *data = level->data;
+    const LevelHeader *header = level->data;
+    unsigned long long maxCells;
+
+    if (level->size < sizeof(LevelHeader)) return 0;
+    if (header->magic != LEVEL_FILE_MAGIC || header->version != LEVEL_FILE_VERSION) return 0;
+    if (header->width == 0 || header->width > LEVEL_MAX_WIDTH || header->height > LEVEL_MAX_HEIGHT) return 0;
+
+    // Cells the data can hold after the header and the column offsets, checked before any pointer is derived
+    if (level->size < GetLevelDataSize(header->width, 0, 0)) return 0;
+    maxCells = (level->size - GetLevelDataSize(header->width, 0, 0))/sizeof(LevelCell);
+    if ((unsigned long long)header->trisCount + header->platfsCount > maxCells) return 0;
+
+    level->header = header;
+    level->trisColumnOffset = (const unsigned int *)(data + sizeof(LevelHeader));
+    level->platfsColumnOffset = level->trisColumnOffset + (header->width + 1);
+    level->tris = (const LevelCell *)(level->platfsColumnOffset + (header->width + 1));
+    level->platfs = level->tris + header->trisCount;
+
+    for (unsigned int x=0; x<header->width; x++)
+    {
+        if (level->trisColumnOffset[x] > level->trisColumnOffset[x + 1]) return 0;
+        if (level->platfsColumnOffset[x] > level->platfsColumnOffset[x + 1]) return 0;
+    }
+
+    if (level->trisColumnOffset[0] != 0 || level->trisColumnOffset[header->width] != header->trisCount) return 0;
+    if (level->platfsColumnOffset[0] != 0 || level->platfsColumnOffset[header->width] != header->platfsCount) return 0;
+
+    // Every cell must be on the column its offset places it and inside the grid
+    for (unsigned int x=0; x<header->width; x++)
+    {
+        for (unsigned int i=level->trisColumnOffset[x]; i<level->trisColumnOffset[x + 1]; i++)
+        {
+            if (level->tris[i].x != x || level->tris[i].y >= header->height) return 0;
+        }
+
+        for (unsigned int i=level->platfsColumnOffset[x]; i<level->platfsColumnOffset[x + 1]; i++)
+        {
+            if (level->platfs[i].x != x || level->platfs[i].y >= header->height) return 0;
+        }
+    }
+
+    return 1;
+}
+
+#if defined(_WIN32)
+static void *MapFile (const char *fileName, unsigned int *size)
+{
+    HANDLE file;
+    HANDLE mapping;
+    LARGE_INTEGER fileSize;
+    void *data = NULL;
+
+    file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && fileSize.QuadPart < 0xffffffff)
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (mapping != NULL)
+        {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            *size = (unsigned int)fileSize.QuadPart;
+            CloseHandle(mapping); // The view keeps the mapping alive
+        }
+    }
+
+    CloseHandle(file);
+
+    return data;
+}
+
+static void UnmapFile (void *data, unsigned int size)
+{
+    UnmapViewOfFile(data);
+}
+#else
+static void *MapFile (const char *fileName, unsigned int *size)
+{
+    struct stat fileStat;
+    void *data = NULL;
+    int file;
+
+    file = open(fileName, O_RDONLY);
+    if (file < 0) return NULL;
+
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0 && fileStat.st_size < 0xffffffff)
+    {
+        data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (data == MAP_FAILED) data = NULL;
+        else *size = (unsigned int)fileStat.st_size;
+    }
+
+    close(file); // The mapping keeps the file alive
+
+    return data;
+}
+
+static void UnmapFile (void *data, unsigned int size)
+{
+    munmap(data, size);
+}
+#endif
@@ -0,0 +1,107 @@
+/*
+*   level.h
+*
+*   Tap To JAmp runtime level format. Made by Marc Montagut - @MarcMDE
+*
+*   A level file only stores the occupied grid cells, sorted by grid column, so it can be
+*   memory mapped and used in place (no decoding step). Layout (little endian, 4 bytes aligned):
+*
+*       LevelHeader     header
+*       unsigned int    trisColumnOffset[width + 1]
+*       unsigned int    platfsColumnOffset[width + 1]
+*       LevelCell       tris[trisCount]
+*       LevelCell       platfs[platfsCount]
+*
+*   Cells of grid column x are in the range [columnOffset[x], columnOffset[x+1]).
+*   Map bitmaps (maps folder) are only an authoring input: red pixels are tris, green pixels platforms.
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#ifndef LEVEL_H
+#define LEVEL_H
+
+// NOTE: This module does not include raylib.h, so it can be used by the offline tools
+// (and by the platform specific file mapping code) without a window or GL context.
+
+#define LEVEL_FILE_MAGIC 0x4c4a5454 // "TTJL"
+#define LEVEL_FILE_VERSION 1
+
+#define LEVEL_MAX_WIDTH 65535
+#define LEVEL_MAX_HEIGHT 255
+
+// Player collision zone limits, shared by the game (see GetPlayerCollisionZone) and levelc
+#define ZONE_MAX_COLUMNS 5 // Grid columns the player collision zone can overlap (checked by screen_gameplay.c)
+#define MAX_ZONE_COLLIDERS 64 // Max colliders (of each kind) on the player collision zone, all of them are tested every frame
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Structs
+// ---------------------------
+typedef enum { LEVEL_CELL_EMPTY = 0, LEVEL_CELL_TRI, LEVEL_CELL_PLATF } LevelCellType;
+
+typedef struct LevelHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int width; // Grid columns
+    unsigned int height; // Grid rows
+    unsigned int trisCount;
+    unsigned int platfsCount;
+}LevelHeader;
+
+typedef struct LevelCell
+{
+    unsigned short x;
+    unsigned char y;
+    unsigned char type; // LevelCellType
+}LevelCell;
+
+typedef struct Level
+{
+    const LevelHeader *header;
+    const unsigned int *trisColumnOffset;
+    const unsigned int *platfsColumnOffset;
+    const LevelCell *tris;
+    const LevelCell *platfs;
+
+    void *data; // Mapped file (or compiled data if isMapped is false)
+    unsigned int size;
+    int isMapped;
+}Level;
+// ----------------------------
+
+// Functions
+// ----------------------------
+int LoadLevel (Level *level, const char *fileName); // Maps a level file, returns 0 on failure
+int LoadLevelFromPixels (Level *level, const unsigned char *pixels, int width, int height); // Compiles RGBA pixels into memory, returns 0 on failure
+void UnloadLevel (Level *level);
+int GetLevelCellType (const unsigned char *pixel); // Classifies an RGBA pixel
+unsigned long long GetLevelDataSize (unsigned int width, unsigned int trisCount, unsigned int platfsCount); // Level file size, in 64-bit (no wrap with any header counts)
+void *CompileLevel (const unsigned char *pixels, int width, int height, unsigned int *size); // Returns level file data (free it!)
+unsigned long long GetLevelHash (const Level *level); // 64-bit FNV-1a of the level data (the same for the file and the compiled bitmap)
+// ----------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEVEL_H
@@ -0,0 +1,628 @@
+/*
+*   particles.c
+*
+*   Tap To JAmp particle emitters. Made by Marc Montagut - @MarcMDE
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#include "particles.h"
+#include "rlgl.h" // Particle quads are batched with rlgl (raylib src folder, see makefile INCLUDES)
+#include "c2dmath.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if !defined(PARTICLES_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define PARTICLES_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if !defined(PARTICLES_NO_THREADS) && !defined(PLATFORM_WEB)
+    #define PARTICLES_THREADS
+    #include <pthread.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PARTICLES_ARRAYS 9 // Float arrays of Particles
+#define PARTICLES_LANES 4 // Emitter slots are padded to it, so the kernel never needs a scalar tail
+#define PARTICLES_PADDED(count) (((count) + PARTICLES_LANES - 1)/PARTICLES_LANES*PARTICLES_LANES)
+#define PARTICLE_RANDOM_VALUES 12 // Random values used to spawn a particle (11, padded to the lanes)
+#define PARTICLES_CHUNK 1024 // Particles integrated per job (multiple of PARTICLES_LANES)
+#define PARTICLES_DRAW_BATCH 1024 // Quads per rlgl batch (raylib MAX_QUADS_BATCH, the smallest one is the GL ES 2 one)
+
+// Random float on the range [min, max), from a random value on the range [0, 1)
+#define RANDOM_RANGE(value, min, max) (((max) - (min))*(value) + (min))
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+#if defined(PARTICLES_THREADS)
+// Worker threads of the update stage, they run jobs until all of them are taken
+typedef struct ParticleWorkers
+{
+    pthread_t threads[PARTICLES_MAX_WORKERS];
+    int threadsCount;
+    int requestedCount; // Threads to start the first time an update reaches PARTICLES_THREADED_MIN
+    bool isStarted;
+    pthread_mutex_t mutex;
+    pthread_cond_t startCond;
+    pthread_cond_t doneCond;
+    int generation; // Increased to start the workers on new jobs
+    int runningCount; // Workers still running the current jobs
+    bool quit;
+    ParticleJob *jobs;
+    int jobsCount;
+    int nextJob; // Next job to take (atomic)
+}ParticleWorkers;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition (local to this module)
+//----------------------------------------------------------------------------------
+static ParticleWorkers workers;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//----------------------------------------------------------------------------------
+static bool InitParticle (Particles *particles, SourceParticle s, float spawnRadius, Vector2 pEPosition, float *random);
+static void GetParticlesRandom (Particles *particles, float *values, int count);
+static bool EvictParticle (ParticleArena *arena, int priority);
+static void RemoveParticle (Particles *particles, int index);
+static void CopyParticle (Particles *particles, int destination, int source);
+static void RunParticleJob (ParticleJob *job);
+static void IntegrateParticles (Particles *particles, int start, int end);
+static int CompactParticles (Particles *particles, int start, int end);
+#if defined(PARTICLES_THREADS)
+static void StartParticleWorkers (void);
+static void RunParticleJobs (void);
+static void *ParticleWorker (void *data);
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// Allocates the slots of all the emitters on a single block (one float array per Particles property)
+void InitParticleArena (ParticleArena *arena, int size, int budget)
+{
+    arena->size = PARTICLES_PADDED(size);
+    arena->data = calloc(arena->size*PARTICLES_ARRAYS, sizeof(float)); // Remember to unload
+    arena->usedSize = 0;
+    arena->budget = budget;
+    arena->activeCount = 0;
+    arena->emittersCount = 0;
+    arena->jobs = malloc(sizeof(ParticleJob)*(arena->size/PARTICLES_CHUNK + PARTICLES_MAX_EMITTERS)); // Remember to unload
+    arena->jobsCount = 0;
+    arena->spawnRandom = malloc(sizeof(float)*arena->size*PARTICLE_RANDOM_VALUES); // Remember to unload
+}
+
+void UnloadParticleArena (ParticleArena *arena)
+{
+    free(arena->data);
+    free(arena->jobs);
+    free(arena->spawnRandom);
+    memset(arena, 0, sizeof(ParticleArena));
+}
+
+// Points the particle arrays to the next free arena slots. Padding slots are never spawned.
+bool InitParticles (Particles *particles, ParticleArena *arena, int count, int priority)
+{
+    int paddedCount = PARTICLES_PADDED(count);
+    float *data = arena->data + arena->usedSize;
+
+    memset(particles, 0, sizeof(Particles));
+    particles->arena = arena;
+    particles->priority = priority;
+    SetParticlesSeed(particles, arena->emittersCount); // Default stream, different for every emitter
+
+    if (arena->usedSize + paddedCount > arena->size || arena->emittersCount >= PARTICLES_MAX_EMITTERS) return false;
+
+    particles->count = count;
+    particles->positionX = data;
+    particles->positionY = particles->positionX + arena->size;
+    particles->velocityX = particles->positionY + arena->size;
+    particles->velocityY = particles->velocityX + arena->size;
+    particles->rotation = particles->velocityY + arena->size;
+    particles->rotationSpeed = particles->rotation + arena->size;
+    particles->scale = particles->rotationSpeed + arena->size;
+    particles->scaleSpeed = particles->scale + arena->size;
+    particles->lifeTime = particles->scaleSpeed + arena->size;
+
+    arena->usedSize += paddedCount;
+    arena->emitters[arena->emittersCount++] = particles;
+
+    return true;
+}
+
+void ResetParticles (Particles *particles)
+{
+    particles->arena->activeCount -= particles->activeCount;
+    particles->activeCount = 0;
+}
+
+// Sets the random stream of the emitter (same seed, same particles)
+void SetParticlesSeed (Particles *particles, unsigned int seed)
+{
+    for (int i=0; i<PARTICLES_LANES; i++)
+    {
+        // Splitmix32 of the seed, one different value per lane (xorshift state can't be 0)
+        unsigned int x = seed + 0x9e3779b9*(i + 1);
+
+        x = (x ^ (x >> 16))*0x85ebca6b;
+        x = (x ^ (x >> 13))*0xc2b2ae35;
+        x ^= x >> 16;
+
+        particles->random[i] = (x != 0) ? x : 0x6d2b79f5;
+    }
+}
+
+// Inits particles on the first free slots (right after the live ones), returns the spawned amount.
+// NOTE: The random values of the whole burst are generated on one pass (up to the emitter free slots, no more can be spawned)
+int SpawnParticles (Particles *particles, SourceParticle s, float spawnRadius, Vector2 pEPosition, int amount)
+{
+    int freeCount = particles->count - particles->activeCount;
+    float *random = particles->arena->spawnRandom;
+    int spawned = 0;
+
+    if (amount > freeCount) amount = freeCount;
+    if (amount <= 0) return 0;
+
+    GetParticlesRandom(particles, random, amount*PARTICLE_RANDOM_VALUES);
+
+    while (spawned < amount && InitParticle(particles, s, spawnRadius, pEPosition, random + spawned*PARTICLE_RANDOM_VALUES)) spawned++;
+
+    return spawned;
+}
+
+// Update stage: integrates the particles of the emitters updated since the last call (see UpdateParticleEmitter()).
+// Emitters are split on PARTICLES_CHUNK jobs, every job compacts its own live particles and the chunks are joined
+// after all of them are done. Jobs don't depend on the workers amount, so results are the same with and without threads.
+void UpdateParticleArena (ParticleArena *arena)
+{
+    int liveCount = 0;
+
+    arena->jobsCount = 0;
+
+    for (int i=0; i<arena->emittersCount; i++)
+    {
+        Particles *particles = arena->emitters[i];
+
+        if (particles->isPending)
+        {
+            for (int start=0; start<particles->activeCount; start+=PARTICLES_CHUNK)
+            {
+                int end = (start + PARTICLES_CHUNK < particles->activeCount) ? start + PARTICLES_CHUNK : particles->activeCount;
+
+                arena->jobs[arena->jobsCount++] = (ParticleJob){ particles, start, end, 0 };
+            }
+
+            liveCount += particles->activeCount;
+        }
+    }
+
+#if defined(PARTICLES_THREADS)
+    if (!workers.isStarted && workers.requestedCount > 0 && liveCount >= PARTICLES_THREADED_MIN) StartParticleWorkers();
+
+    if (workers.threadsCount > 0 && liveCount >= PARTICLES_THREADED_MIN)
+    {
+        pthread_mutex_lock(&workers.mutex);
+        workers.jobs = arena->jobs;
+        workers.jobsCount = arena->jobsCount;
+        workers.nextJob = 0;
+        workers.runningCount = workers.threadsCount;
+        workers.generation++;
+        pthread_cond_broadcast(&workers.startCond);
+        pthread_mutex_unlock(&workers.mutex);
+
+        RunParticleJobs();
+
+        // Wait for the workers (barrier)
+        pthread_mutex_lock(&workers.mutex);
+        while (workers.runningCount > 0) pthread_cond_wait(&workers.doneCond, &workers.mutex);
+        pthread_mutex_unlock(&workers.mutex);
+    }
+    else
+#endif
+    {
+        for (int i=0; i<arena->jobsCount; i++) RunParticleJob(&arena->jobs[i]);
+    }
+
+    // Join the chunks live particles (jobs are in emitter and chunk order)
+    for (int i=0; i<arena->jobsCount; i++)
+    {
+        ParticleJob *job = &arena->jobs[i];
+        Particles *particles = job->particles;
+
+        if (job->start == 0) particles->activeCount = 0;
+
+        if (particles->activeCount != job->start)
+        {
+            for (int j=0; j<PARTICLES_ARRAYS; j++)
+            {
+                float *array = particles->positionX + j*arena->size; // Property arrays are arena->size apart
+
+                memmove(array + particles->activeCount, array + job->start, sizeof(float)*job->aliveCount);
+            }
+        }
+
+        particles->activeCount += job->aliveCount;
+    }
+
+    arena->activeCount = 0;
+
+    for (int i=0; i<arena->emittersCount; i++)
+    {
+        arena->emitters[i]->isMoving = arena->emitters[i]->isPending;
+        arena->emitters[i]->isPending = false;
+        arena->activeCount += arena->emitters[i]->activeCount;
+    }
+}
+
+// Draws the live particles as rotated and scaled quads (same as DrawTexturePro() with the sourceRec of the texture), all of
+// them on the same rlgl batch. Particles are drawn at position - offset, rotated around the sprite center (scaled or not).
+// NOTE: The rlgl buffers are drawn before (they can hold any amount of previous quads) and every PARTICLES_DRAW_BATCH quads,
+// so they never overflow.
+// Particles are drawn at alpha between the last two updates: an update adds the (updated) speeds to the properties,
+// so the previous values are the current ones minus the speeds (no need to keep them).
+void DrawParticles (Particles *particles, Texture2D texture, Rectangle sourceRec, Vector2 offset, Color color, bool isOriginScaled, float alpha)
+{
+    float texCoordsX[4] = { (float)sourceRec.x/texture.width, (float)sourceRec.x/texture.width,
+                            (float)(sourceRec.x + sourceRec.width)/texture.width, (float)(sourceRec.x + sourceRec.width)/texture.width };
+    float texCoordsY[4] = { (float)sourceRec.y/texture.height, (float)(sourceRec.y + sourceRec.height)/texture.height,
+                            (float)(sourceRec.y + sourceRec.height)/texture.height, (float)sourceRec.y/texture.height };
+    float back = particles->isMoving ? 1 - alpha : 0; // Update fraction not drawn yet
+
+    if (particles->activeCount == 0) return;
+
+    rlglDraw(); // Starts on an empty batch, so every PARTICLES_DRAW_BATCH quads fit
+    rlEnableTexture(texture.id);
+    rlBegin(RL_QUADS);
+
+    for (int i=0; i<particles->activeCount; i++)
+    {
+        float scale = particles->scale[i] - particles->scaleSpeed[i]*back;
+        float width = sourceRec.width*scale;
+        float height = sourceRec.height*scale;
+        float originX = isOriginScaled ? width/2 : sourceRec.width/2;
+        float originY = isOriginScaled ? height/2 : sourceRec.height/2;
+        float angle = -(particles->rotation[i] - particles->rotationSpeed[i]*back)*DEG2RAD;
+        float cosAngle = cosf(angle);
+        float sinAngle = sinf(angle);
+        float x = particles->positionX[i] - particles->velocityX[i]*back - offset.x;
+        float y = particles->positionY[i] - particles->velocityY[i]*back - offset.y;
+        float cornersX[4] = { -originX, -originX, width - originX, width - originX };
+        float cornersY[4] = { -originY, height - originY, height - originY, -originY };
+
+        if (i > 0 && i%PARTICLES_DRAW_BATCH == 0)
+        {
+            rlEnd();
+            rlglDraw();
+            rlBegin(RL_QUADS);
+        }
+
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        for (int j=0; j<4; j++)
+        {
+            rlTexCoord2f(texCoordsX[j], texCoordsY[j]);
+            rlVertex2f(x + cornersX[j]*cosAngle - cornersY[j]*sinAngle, y + cornersX[j]*sinAngle + cornersY[j]*cosAngle);
+        }
+    }
+
+    rlEnd();
+    rlDisableTexture();
+}
+
+// Sets the worker threads of the update stage (count 0 keeps it on the calling thread)
+// NOTE: Threads are started by the first update with PARTICLES_THREADED_MIN live particles, smaller arenas never start them
+void InitParticleWorkers (int count)
+{
+#if defined(PARTICLES_THREADS)
+    if (count > PARTICLES_MAX_WORKERS) count = PARTICLES_MAX_WORKERS;
+
+    workers.requestedCount = count;
+    workers.threadsCount = 0;
+    workers.isStarted = false;
+#endif
+}
+
+void CloseParticleWorkers (void)
+{
+#if defined(PARTICLES_THREADS)
+    workers.requestedCount = 0;
+
+    if (!workers.isStarted) return;
+
+    workers.isStarted = false;
+
+    pthread_mutex_lock(&workers.mutex);
+    workers.quit = true;
+    pthread_cond_broadcast(&workers.startCond);
+    pthread_mutex_unlock(&workers.mutex);
+
+    for (int i=0; i<workers.threadsCount; i++) pthread_join(workers.threads[i], NULL);
+
+    workers.threadsCount = 0;
+    pthread_cond_destroy(&workers.doneCond);
+    pthread_cond_destroy(&workers.startCond);
+    pthread_mutex_destroy(&workers.mutex);
+#endif
+}
+
+int GetParticleWorkersCount (void)
+{
+#if defined(PARTICLES_THREADS)
+    return workers.threadsCount;
+#else
+    return 0;
+#endif
+}
+
+void UpdateParticleEmitter (ParticleEmitter *pE, Vector2 position)
+{
+    if (pE->isActive)
+    {
+        pE->position = Vector2Add(position, pE->offset);
+
+        if (!pE->isBurst)
+        {
+            pE->frameParticles = pE->ppf + pE->remainingParticles;
+            pE->particlesAmount = pE->frameParticles/1;
+            pE->remainingParticles = fmod(pE->frameParticles, 1);
+
+            if (pE->particlesAmount > 0) pE->particlesAmount -= SpawnParticles(&pE->particles, pE->source, pE->spawnRadius, pE->position, pE->particlesAmount);
+        }
+
+        // Particles are integrated on the next UpdateParticleArena()
+        pE->particles.gravityForce = pE->gravity.force;
+        pE->particles.isPending = true;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Inits a particle on the first free slot from PARTICLE_RANDOM_VALUES random values
+static bool InitParticle (Particles *particles, SourceParticle s, float spawnRadius, Vector2 pEPosition, float *random)
+{
+    int index = particles->activeCount;
+    Vector2 position;
+
+    if (index >= particles->count) return false;
+    if (particles->arena->activeCount >= particles->arena->budget && !EvictParticle(particles->arena, particles->priority)) return false;
+
+    if (spawnRadius!= 0)
+    {
+        position = Vector2Add(pEPosition, (Vector2){0, RANDOM_RANGE(random[0], 0, -spawnRadius)});
+        Vector2Rotate(&position, pEPosition, random[1]*361); // Angle on the range [0, 360]
+    }
+    else position = pEPosition;
+
+    particles->positionX[index] = position.x;
+    particles->positionY[index] = position.y;
+    particles->rotation[index] = RANDOM_RANGE(random[2], s.rotation[0], s.rotation[1]);
+    particles->scale[index] = RANDOM_RANGE(random[3], s.scale[0], s.scale[1]);
+    particles->velocityX[index] = RANDOM_RANGE(random[4], s.movementSpeed[0].x, s.movementSpeed[1].x)*RANDOM_RANGE(random[5], s.direction[0].x, s.direction[1].x);
+    particles->velocityY[index] = RANDOM_RANGE(random[6], s.movementSpeed[0].y, s.movementSpeed[1].y)*RANDOM_RANGE(random[7], s.direction[0].y, s.direction[1].y);
+    particles->rotationSpeed[index] = RANDOM_RANGE(random[8], s.rotationSpeed[0], s.rotationSpeed[1]);
+    particles->scaleSpeed[index] = RANDOM_RANGE(random[9], s.scaleSpeed[0], s.scaleSpeed[1]);
+    particles->lifeTime[index] = s.lifeTime[0] + (int)(random[10]*(s.lifeTime[1] - s.lifeTime[0] + 1)); // Integer on the range [min, max]
+
+    particles->activeCount++;
+    particles->arena->activeCount++;
+
+    return true;
+}
+
+// Fills values with random floats on the range [0, 1), count must be a multiple of PARTICLES_LANES.
+// NOTE: One xorshift32 stream per lane, both paths give the same values.
+static void GetParticlesRandom (Particles *particles, float *values, int count)
+{
+#if defined(PARTICLES_SSE2)
+    __m128i x = _mm_loadu_si128((__m128i *)particles->random);
+    __m128 scale = _mm_set1_ps(1.0f/16777216);
+
+    for (int i=0; i<count; i+=PARTICLES_LANES)
+    {
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+
+        // Top 24 bits, exact on a float
+        _mm_storeu_ps(values + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(x, 8)), scale));
+    }
+
+    _mm_storeu_si128((__m128i *)particles->random, x);
+#else
+    for (int i=0; i<count; i+=PARTICLES_LANES)
+    {
+        for (int j=0; j<PARTICLES_LANES; j++)
+        {
+            unsigned int x = particles->random[j];
+
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+
+            particles->random[j] = x;
+            values[i + j] = (x >> 8)*(1.0f/16777216);
+        }
+    }
+#endif
+}
+
+// Removes the newest particle of the lowest priority emitter (below the given priority) to free budget
+static bool EvictParticle (ParticleArena *arena, int priority)
+{
+    Particles *victim = NULL;
+
+    for (int i=0; i<arena->emittersCount; i++)
+    {
+        Particles *particles = arena->emitters[i];
+
+        if (particles->activeCount > 0 && particles->priority < priority && (victim == NULL || particles->priority < victim->priority)) victim = particles;
+    }
+
+    if (victim == NULL) return false;
+
+    RemoveParticle(victim, victim->activeCount - 1);
+
+    return true;
+}
+
+// Moves the last live particle over the removed one
+static void RemoveParticle (Particles *particles, int index)
+{
+    int last = --particles->activeCount;
+
+    particles->arena->activeCount--;
+
+    CopyParticle(particles, index, last);
+}
+
+static void CopyParticle (Particles *particles, int destination, int source)
+{
+    particles->positionX[destination] = particles->positionX[source];
+    particles->positionY[destination] = particles->positionY[source];
+    particles->velocityX[destination] = particles->velocityX[source];
+    particles->velocityY[destination] = particles->velocityY[source];
+    particles->rotation[destination] = particles->rotation[source];
+    particles->rotationSpeed[destination] = particles->rotationSpeed[source];
+    particles->scale[destination] = particles->scale[source];
+    particles->scaleSpeed[destination] = particles->scaleSpeed[source];
+    particles->lifeTime[destination] = particles->lifeTime[source];
+}
+
+static void RunParticleJob (ParticleJob *job)
+{
+    IntegrateParticles(job->particles, job->start, job->end);
+    job->aliveCount = CompactParticles(job->particles, job->start, job->end);
+}
+
+// Adds gravity to the velocity, moves, rotates and scales the particles on the range and consumes one frame of their life.
+// NOTE: Start must be a multiple of PARTICLES_LANES. Lanes past the end (up to the padding) are also integrated,
+// they are free slots so it doesn't matter.
+static void IntegrateParticles (Particles *particles, int start, int end)
+{
+#if defined(PARTICLES_SSE2)
+    __m128 one = _mm_set1_ps(1);
+    __m128 gravityX = _mm_set1_ps(particles->gravityForce.x);
+    __m128 gravityY = _mm_set1_ps(particles->gravityForce.y);
+
+    for (int i=start; i<end; i+=PARTICLES_LANES)
+    {
+        __m128 velocityX = _mm_add_ps(_mm_loadu_ps(particles->velocityX + i), gravityX);
+        __m128 velocityY = _mm_add_ps(_mm_loadu_ps(particles->velocityY + i), gravityY);
+
+        _mm_storeu_ps(particles->velocityX + i, velocityX);
+        _mm_storeu_ps(particles->velocityY + i, velocityY);
+        _mm_storeu_ps(particles->positionX + i, _mm_add_ps(_mm_loadu_ps(particles->positionX + i), velocityX));
+        _mm_storeu_ps(particles->positionY + i, _mm_add_ps(_mm_loadu_ps(particles->positionY + i), velocityY));
+        _mm_storeu_ps(particles->rotation + i, _mm_add_ps(_mm_loadu_ps(particles->rotation + i), _mm_loadu_ps(particles->rotationSpeed + i)));
+        _mm_storeu_ps(particles->scale + i, _mm_add_ps(_mm_loadu_ps(particles->scale + i), _mm_loadu_ps(particles->scaleSpeed + i)));
+        _mm_storeu_ps(particles->lifeTime + i, _mm_sub_ps(_mm_loadu_ps(particles->lifeTime + i), one));
+    }
+#else
+    for (int i=start; i<end; i++)
+    {
+        particles->velocityX[i] += particles->gravityForce.x;
+        particles->velocityY[i] += particles->gravityForce.y;
+        particles->positionX[i] += particles->velocityX[i];
+        particles->positionY[i] += particles->velocityY[i];
+        particles->rotation[i] += particles->rotationSpeed[i];
+        particles->scale[i] += particles->scaleSpeed[i];
+        particles->lifeTime[i]--;
+    }
+#endif
+}
+
+// Packs the live particles of the range at its start (dead ones are replaced by the last live one), returns their amount
+static int CompactParticles (Particles *particles, int start, int end)
+{
+    int last = end;
+
+    for (int i=start; i<last;)
+    {
+        if (particles->lifeTime[i] <= 0) CopyParticle(particles, i, --last);
+        else i++;
+    }
+
+    return last - start;
+}
+
+#if defined(PARTICLES_THREADS)
+static void RunParticleJobs (void)
+{
+    for (;;)
+    {
+        int i = __sync_fetch_and_add(&workers.nextJob, 1);
+
+        if (i >= workers.jobsCount) break;
+
+        RunParticleJob(&workers.jobs[i]);
+    }
+}
+
+static void StartParticleWorkers (void)
+{
+    pthread_mutex_init(&workers.mutex, NULL);
+    pthread_cond_init(&workers.startCond, NULL);
+    pthread_cond_init(&workers.doneCond, NULL);
+    workers.generation = 0;
+    workers.runningCount = 0;
+    workers.quit = false;
+    workers.threadsCount = 0;
+    workers.isStarted = true;
+
+    for (int i=0; i<workers.requestedCount; i++)
+    {
+        if (pthread_create(&workers.threads[workers.threadsCount], NULL, ParticleWorker, NULL) == 0) workers.threadsCount++;
+    }
+}
+
+static void *ParticleWorker (void *data)
+{
+    int generation = 0;
+
+    pthread_mutex_lock(&workers.mutex);
+
+    for (;;)
+    {
+        while (workers.generation == generation && !workers.quit) pthread_cond_wait(&workers.startCond, &workers.mutex);
+
+        if (workers.quit) break;
+
+        generation = workers.generation;
+        pthread_mutex_unlock(&workers.mutex);
+
+        RunParticleJobs();
+
+        pthread_mutex_lock(&workers.mutex);
+        if (--workers.runningCount == 0) pthread_cond_signal(&workers.doneCond);
+    }
+
+    pthread_mutex_unlock(&workers.mutex);
+
+    return NULL;
+}
+#endif
@@ -0,0 +1,154 @@
+/*
+*   particles.h
+*
+*   Tap To JAmp particle emitters. Made by Marc Montagut - @MarcMDE
+*
+*   Particles are stored as a structure of arrays (one float array per property), so a single
+*   kernel updates the whole emitter at once (4 particles per step when SSE2 is available).
+*   Live particles are kept packed at the start of the arrays: spawning appends one, and a dead
+*   particle is replaced by the last live one, so update and draw only touch live particles.
+*
+*   All the emitters take their slots from one arena, allocated once. The arena also has a budget
+*   of live particles (shared by all the emitters): when it is reached, spawning a particle evicts
+*   one from the lowest priority emitter below the spawning one (or fails if there is none).
+*
+*   Emitters are integrated all together on the update stage (UpdateParticleArena), split on jobs
+*   that run on a pool of worker threads when there are enough live particles.
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"
+
+#define PARTICLES_MAX_EMITTERS 16 // Max emitters on an arena
+#define PARTICLES_MAX_WORKERS 16 // Max worker threads of the update stage
+#define PARTICLES_THREADED_MIN 4096 // Live particles to update below it, the update stage runs on the calling thread
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Structs
+// ---------------------------
+typedef struct GravityForce
+{
+    Vector2 direction;
+    float value;
+    Vector2 force;
+}GravityForce;
+
+typedef struct SourceParticle
+{
+    float rotation[2];
+    float scale[2];
+    Vector2 direction[2];
+    Vector2 movementSpeed[2];
+    float rotationSpeed[2];
+    float scaleSpeed[2];
+    int lifeTime[2];
+    Color color;
+    Texture2D texture;
+    Rectangle textureRec; // Sprite on the texture (atlas)
+}SourceParticle;
+
+// Update stage job: a chunk of the particles of an emitter
+typedef struct ParticleJob
+{
+    struct Particles *particles;
+    int start;
+    int end;
+    int aliveCount; // Live particles after the update (packed at start)
+}ParticleJob;
+
+typedef struct ParticleArena
+{
+    float *data; // Slots of all the emitters, remember to unload
+    int size; // Slots
+    int usedSize; // Slots given to emitters
+    int budget; // Max live particles (of all the emitters)
+    int activeCount; // Live particles (of all the emitters)
+    struct Particles *emitters[PARTICLES_MAX_EMITTERS];
+    int emittersCount;
+    ParticleJob *jobs; // Update stage jobs, remember to unload
+    int jobsCount;
+    float *spawnRandom; // Random values of a spawn burst (one emitter slots at most), remember to unload
+}ParticleArena;
+
+typedef struct Particles
+{
+    ParticleArena *arena;
+    int priority; // Particles of lower priority emitters are evicted first when the arena budget is reached
+    int count; // Particle slots (padded to a multiple of 4 on the arena)
+    int activeCount; // Live particles, always in the range [0, activeCount)
+    unsigned int random[4]; // Spawn random stream (4 xorshift32 lanes), set with SetParticlesSeed()
+    Vector2 gravityForce;
+    bool isPending; // Waiting for UpdateParticleArena()
+    bool isMoving; // Integrated on the last UpdateParticleArena() (drawn interpolated)
+    float *positionX;
+    float *positionY;
+    float *velocityX;
+    float *velocityY;
+    float *rotation;
+    float *rotationSpeed;
+    float *scale;
+    float *scaleSpeed;
+    float *lifeTime; // Frames left
+}Particles;
+
+typedef struct ParticleEmitter
+{
+    Vector2 position;
+    Vector2 offset;
+    float spawnRadius;
+    GravityForce gravity;
+    float ppf; // ParticlesPerFrame
+    float frameParticles; // Total frame particles
+    float remainingParticles; // Decimal particles left
+    int particlesAmount; // Particles that will be spawned on the current frame
+    SourceParticle source;
+    Particles particles;
+    bool isBurst;
+    bool isActive;
+}ParticleEmitter;
+// ----------------------------
+
+// Functions
+// ----------------------------
+void InitParticleArena (ParticleArena *arena, int size, int budget);
+void UnloadParticleArena (ParticleArena *arena);
+bool InitParticles (Particles *particles, ParticleArena *arena, int count, int priority); // Takes the slots from the arena, returns false if it is full
+void ResetParticles (Particles *particles); // Kills all the particles
+void SetParticlesSeed (Particles *particles, unsigned int seed);
+int SpawnParticles (Particles *particles, SourceParticle s, float spawnRadius, Vector2 pEPosition, int amount); // Returns the spawned amount (less if there are no free slots)
+void UpdateParticleEmitter (ParticleEmitter *pE, Vector2 position); // Spawns particles, they are integrated on UpdateParticleArena()
+void UpdateParticleArena (ParticleArena *arena); // Integrates the particles of the updated emitters and removes the dead ones
+void DrawParticles (Particles *particles, Texture2D texture, Rectangle sourceRec, Vector2 offset, Color color, bool isOriginScaled, float alpha); // Draws all the live particles on one batch, alpha [0, 1] interpolates the last update
+void InitParticleWorkers (int count);
+void CloseParticleWorkers (void);
+int GetParticleWorkersCount (void); // Running worker threads (0 until an update reaches PARTICLES_THREADED_MIN)
+// ----------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARTICLES_H
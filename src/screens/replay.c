@@ -0,0 +1,158 @@
+/*
+*   replay.c
+*
+*   Tap To JAmp gameplay replays. Made by Marc Montagut - @MarcMDE
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define REPLAY_MIN_CAPACITY 256 // Runs
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+void InitReplay (Replay *replay, unsigned long long levelHash, unsigned int seed)
+{
+    memset(replay, 0, sizeof(Replay));
+
+    replay->levelHash = levelHash;
+    replay->seed = seed;
+}
+
+void UnloadReplay (Replay *replay)
+{
+    free(replay->runs);
+
+    memset(replay, 0, sizeof(Replay));
+}
+
+void RecordReplayInput (Replay *replay, unsigned short input)
+{
+    ReplayRun *lastRun = (replay->runsCount > 0) ? &replay->runs[replay->runsCount - 1] : NULL;
+
+    if (lastRun != NULL && lastRun->input == input && lastRun->lenght < REPLAY_MAX_RUN_LENGHT) lastRun->lenght++;
+    else
+    {
+        if (replay->runsCount == replay->runsCapacity)
+        {
+            int capacity = (replay->runsCapacity == 0) ? REPLAY_MIN_CAPACITY : replay->runsCapacity*2;
+            ReplayRun *runs = realloc(replay->runs, sizeof(ReplayRun)*capacity);
+
+            if (runs == NULL) return; // Recording stops (the replay is still valid up to here)
+
+            replay->runs = runs;
+            replay->runsCapacity = capacity;
+        }
+
+        replay->runs[replay->runsCount++] = (ReplayRun){ input, 1 };
+    }
+
+    replay->stepsCount++;
+}
+
+// Walks the runs from the last read one (or from the start when going back)
+unsigned short GetReplayInput (Replay *replay, int step)
+{
+    if (step < 0 || step >= replay->stepsCount) return 0;
+
+    if (step < replay->readRunStep)
+    {
+        replay->readRun = 0;
+        replay->readRunStep = 0;
+    }
+
+    while (step >= replay->readRunStep + replay->runs[replay->readRun].lenght)
+    {
+        replay->readRunStep += replay->runs[replay->readRun].lenght;
+        replay->readRun++;
+    }
+
+    return replay->runs[replay->readRun].input;
+}
+
+int SaveReplay (Replay *replay, const char *fileName)
+{
+    ReplayHeader header = { REPLAY_FILE_MAGIC, REPLAY_FILE_VERSION, replay->levelHash, replay->seed, replay->stepsCount, replay->runsCount, 0 };
+    FILE *file = fopen(fileName, "wb");
+    int isSaved;
+
+    if (file == NULL) return 0;
+
+    isSaved = (fwrite(&header, sizeof(ReplayHeader), 1, file) == 1 && (int)fwrite(replay->runs, sizeof(ReplayRun), replay->runsCount, file) == replay->runsCount);
+
+    if (fclose(file) != 0) isSaved = 0;
+    if (!isSaved) remove(fileName);
+
+    return isSaved;
+}
+
+int LoadReplay (Replay *replay, const char *fileName)
+{
+    ReplayHeader header;
+    FILE *file = fopen(fileName, "rb");
+    long fileSize = -1;
+    unsigned long long stepsCount = 0;
+    int isValid = 0;
+
+    memset(replay, 0, sizeof(Replay));
+
+    if (file == NULL) return 0;
+
+    if (fseek(file, 0, SEEK_END) == 0) fileSize = ftell(file);
+
+    // Counts must fit the Replay ints (and the extra run slot) and the runs must fit the file, before allocating them
+    if (fileSize >= (long)sizeof(ReplayHeader) && fseek(file, 0, SEEK_SET) == 0 &&
+        fread(&header, sizeof(ReplayHeader), 1, file) == 1 && header.magic == REPLAY_FILE_MAGIC && header.version == REPLAY_FILE_VERSION &&
+        header.stepsCount <= INT_MAX && header.runsCount < INT_MAX && header.runsCount <= header.stepsCount &&
+        header.runsCount <= (unsigned long)(fileSize - sizeof(ReplayHeader))/sizeof(ReplayRun))
+    {
+        replay->runs = malloc(sizeof(ReplayRun)*((size_t)header.runsCount + 1)); // Remember to free
+
+        if (replay->runs != NULL && fread(replay->runs, sizeof(ReplayRun), header.runsCount, file) == header.runsCount)
+        {
+            // Runs must add up to the steps (so playback never reads past them)
+            for (unsigned int i=0; i<header.runsCount; i++) stepsCount += replay->runs[i].lenght;
+
+            isValid = (stepsCount == header.stepsCount);
+        }
+    }
+
+    fclose(file);
+
+    if (!isValid)
+    {
+        UnloadReplay(replay);
+        return 0;
+    }
+
+    replay->levelHash = header.levelHash;
+    replay->seed = header.seed;
+    replay->stepsCount = header.stepsCount;
+    replay->runsCount = header.runsCount;
+    replay->runsCapacity = header.runsCount + 1;
+
+    return 1;
+}
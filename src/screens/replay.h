@@ -0,0 +1,93 @@
+/*
+*   replay.h
+*
+*   Tap To JAmp gameplay replays. Made by Marc Montagut - @MarcMDE
+*
+*   A replay stores the input read by every gameplay simulation step (see GetGameInputState) as
+*   runs of steps with the same input, so held keys and idle time cost one run each. With the level
+*   hash and the random seed of the session, the steps can be simulated again with the same results.
+*   Layout (little endian, 4 bytes aligned):
+*
+*       ReplayHeader    header
+*       ReplayRun       runs[runsCount]
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// NOTE: This module does not include raylib.h, replays are read by the headless simulation too
+
+#define REPLAY_FILE_MAGIC 0x50524a54 // "TJRP"
+#define REPLAY_FILE_VERSION 1
+
+#define REPLAY_MAX_RUN_LENGHT 65535 // Longer runs are split
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Structs
+// ---------------------------
+typedef struct ReplayHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned long long levelHash; // GetLevelHash() of the played level
+    unsigned int seed; // Gameplay random seed
+    unsigned int stepsCount;
+    unsigned int runsCount;
+    unsigned int reserved;
+}ReplayHeader;
+
+typedef struct ReplayRun
+{
+    unsigned short input; // GetGameInputState()
+    unsigned short lenght; // Steps
+}ReplayRun;
+
+typedef struct Replay
+{
+    unsigned long long levelHash;
+    unsigned int seed;
+    int stepsCount;
+    ReplayRun *runs; // Remember to unload
+    int runsCount;
+    int runsCapacity;
+    int readRun; // Playback position: run of the last read step, and its first step
+    int readRunStep;
+}Replay;
+// ----------------------------
+
+// Functions
+// ----------------------------
+void InitReplay (Replay *replay, unsigned long long levelHash, unsigned int seed); // Starts an empty recording
+void UnloadReplay (Replay *replay);
+void RecordReplayInput (Replay *replay, unsigned short input); // Appends the input of the next step
+unsigned short GetReplayInput (Replay *replay, int step); // Input of a step (0 after the last one), fast when read in order
+int SaveReplay (Replay *replay, const char *fileName); // Returns 0 on failure
+int LoadReplay (Replay *replay, const char *fileName); // Returns 0 on failure
+// ----------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REPLAY_H
@@ -0,0 +1,720 @@
+/*
+*   satcollision.c
+*
+*   2D SAT collisions detection C library made by Marc Montagut - @MarcMDE
+*
+*   NOTE: Touching polygons (projections sharing a limit) are considered as colliding.
+*   Batch functions test one polygon against many colliders stored as structure of arrays, using
+*   SSE2 (4 colliders per step) or AVX2 (8 colliders per step, selected at runtime if the CPU supports it).
+*   Define SAT_NO_SIMD to only use the scalar path. All the paths give the same results.
+*   Define SAT_VERIFY_FAST_PATH to also run the full SAT when the axis aligned fast path is used (aborts if they differ).
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#include "satcollision.h"
+#include <stdlib.h>
+#include <math.h>
+#if defined(SAT_VERIFY_FAST_PATH)
+    #include <stdio.h>
+#endif
+
+#if !defined(SAT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define SAT_SSE2
+    #include <emmintrin.h>
+
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define SAT_AVX2 // Compiled with the target attribute, only used if the CPU supports it
+        #include <immintrin.h>
+    #endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SAT_MIN(a, b) (((a) < (b)) ? (a) : (b)) // Same NaN behaviour than _mm_min_ps()
+#define SAT_MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Separating axes of a batch test, with the tested polygon already projected on them
+typedef struct BatchAxes
+{
+    float *x;
+    float *y;
+    float *min;
+    float *max;
+    int count;
+}BatchAxes;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//----------------------------------------------------------------------------------
+static bool IsAABox (Vector2 *points, int lenght);
+static void SetBatchAxis (BatchAxes *axes, int index, Vector2 *points, int lenght, Vector2 normal);
+static int TrisBatch (BatchAxes axes, SATTriBatch tris, unsigned char *results);
+static int AABoxesBatch (BatchAxes axes, SATAABoxBatch boxes, unsigned char *results);
+#if defined(SAT_VERIFY_FAST_PATH)
+static void VerifyFastPath (unsigned char *fastResults, unsigned char *satResults, int count);
+#endif
+static int TrisBatchScalar (BatchAxes axes, SATTriBatch tris, int start, unsigned char *results);
+static int AABoxesBatchScalar (BatchAxes axes, SATAABoxBatch boxes, int start, unsigned char *results);
+#if defined(SAT_SSE2)
+static int TrisBatchSSE2 (BatchAxes axes, SATTriBatch tris, int *end, unsigned char *results);
+static int AABoxesBatchSSE2 (BatchAxes axes, SATAABoxBatch boxes, int *end, unsigned char *results);
+#endif
+#if defined(SAT_AVX2)
+static int TrisBatchAVX2 (BatchAxes axes, SATTriBatch tris, int *end, unsigned char *results);
+static int AABoxesBatchAVX2 (BatchAxes axes, SATAABoxBatch boxes, int *end, unsigned char *results);
+static bool IsAVX2Supported ();
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+Texture2D CreateWhitePixelTexture ()
+{
+    Color pixel = WHITE;
+    Image image = LoadImageEx(&pixel, 1, 1);
+    Texture2D texture = LoadTextureFromImage(image);
+
+    UnloadImage(image);
+
+    return texture;
+}
+
+Vector2 GetNormal(Vector2 a, Vector2 b, bool left)
+{
+    Vector2 edge = { b.x - a.x, b.y - a.y };
+    Vector2 normal;
+    float lenght = sqrtf(edge.x*edge.x + edge.y*edge.y);
+
+    if (left) normal = (Vector2){ -edge.y, edge.x };
+    else normal = (Vector2){ edge.y, -edge.x };
+
+    // Degenerated edge: null axis (every projection overlaps, so it never separates)
+    if (lenght == 0) return (Vector2){ 0, 0 };
+
+    return (Vector2){ normal.x/lenght, normal.y/lenght };
+}
+
+void SetNormals (Vector2 *points, Vector2 *normals, int lenght, bool left)
+{
+    for (int i=0; i<lenght; i++) normals[i] = GetNormal(points[i], points[(i + 1)%lenght], left);
+}
+
+// NOTE: angle in degrees, quarter turns are exact (so a rotated axis aligned box stays axis aligned)
+void RotatePoints (Vector2 *points, int lenght, Vector2 pivot, float angle)
+{
+    float c = cosf(angle*DEG2RAD);
+    float s = sinf(angle*DEG2RAD);
+    float quarterTurns = angle/90.0f;
+
+    if (quarterTurns == (int)quarterTurns)
+    {
+        const float quarterCos[4] = { 1, 0, -1, 0 };
+        const float quarterSin[4] = { 0, 1, 0, -1 };
+        int quarter = (((int)quarterTurns)%4 + 4)%4;
+
+        c = quarterCos[quarter];
+        s = quarterSin[quarter];
+    }
+
+    for (int i=0; i<lenght; i++)
+    {
+        float x = points[i].x - pivot.x;
+        float y = points[i].y - pivot.y;
+
+        points[i].x = pivot.x + x*c - y*s;
+        points[i].y = pivot.y + x*s + y*c;
+    }
+}
+
+Value2 GetProjectedMinMax (Vector2 *points, int lenght, Vector2 normal)
+{
+    Value2 minMax;
+
+    minMax.a = points[0].x*normal.x + points[0].y*normal.y;
+    minMax.b = minMax.a;
+
+    for (int i=1; i<lenght; i++)
+    {
+        float projection = points[i].x*normal.x + points[i].y*normal.y;
+
+        minMax.a = SAT_MIN(projection, minMax.a);
+        minMax.b = SAT_MAX(projection, minMax.b);
+    }
+
+    return minMax;
+}
+
+bool MinMaxCollide (Value2 a, Value2 b)
+{
+    return (a.b >= b.a && b.b >= a.a);
+}
+
+void InitSATBox (SATBox *box, Vector2 position, Vector2 size, float rotation)
+{
+    UpdateSATBox(box, position, size, rotation);
+}
+
+void InitSATTri (SATTri *tri, Vector2 position, Vector2 size, float rotation)
+{
+    UpdateSATTri(tri, position, size, rotation);
+}
+
+void InitSATRegPoly (SATRegPoly *poly, Vector2 position, float radius, int sides, float rotation)
+{
+    poly->sides = sides;
+    poly->points = malloc(sizeof(Vector2)*sides); // Remember to free
+
+    UpdateSATRegPoly(poly, position, radius, rotation);
+}
+
+void UpdateSATBox (SATBox *box, Vector2 position, Vector2 size, float rotation)
+{
+    box->size = size;
+    box->rotation = rotation;
+
+    UpdateAASATBoxPosition(box, position);
+    if (rotation != 0) RotatePoints(box->points, 4, box->position, rotation);
+}
+
+void UpdateSATTri (SATTri *tri, Vector2 position, Vector2 size, float rotation)
+{
+    tri->size = size;
+    tri->rotation = rotation;
+
+    UpdateAASATTriPosition(tri, position);
+    if (rotation != 0) RotatePoints(tri->points, 3, tri->position, rotation);
+}
+
+void UpdateAASATBoxPosition (SATBox *box, Vector2 position)
+{
+    float halfWidth = box->size.x*0.5f;
+    float halfHeight = box->size.y*0.5f;
+
+    box->position = position;
+
+    // Clockwise from top-left corner
+    box->points[0] = (Vector2){ position.x - halfWidth, position.y - halfHeight };
+    box->points[1] = (Vector2){ position.x + halfWidth, position.y - halfHeight };
+    box->points[2] = (Vector2){ position.x + halfWidth, position.y + halfHeight };
+    box->points[3] = (Vector2){ position.x - halfWidth, position.y + halfHeight };
+}
+
+void UpdateAASATTriPosition (SATTri *tri, Vector2 position)
+{
+    float halfWidth = tri->size.x*0.5f;
+    float halfHeight = tri->size.y*0.5f;
+
+    tri->position = position;
+
+    // Bottom-left, top, bottom-right
+    tri->points[0] = (Vector2){ position.x - halfWidth, position.y + halfHeight };
+    tri->points[1] = (Vector2){ position.x, position.y - halfHeight };
+    tri->points[2] = (Vector2){ position.x + halfWidth, position.y + halfHeight };
+}
+
+void UpdateSATRegPoly (SATRegPoly *poly, Vector2 position, float radius, float rotation)
+{
+    poly->position = position;
+    poly->radius = radius;
+    poly->rotation = rotation;
+
+    for (int i=0; i<poly->sides; i++)
+    {
+        float angle = (rotation + 360.0f/poly->sides*i)*DEG2RAD;
+
+        poly->points[i] = (Vector2){ position.x + cosf(angle)*radius, position.y + sinf(angle)*radius };
+    }
+}
+
+bool SATPolysCollide (Vector2 *p1Points, int p1Lenght, Vector2 *p2Points, int p2Lenght)
+{
+    for (int i=0; i<p1Lenght; i++)
+    {
+        Vector2 normal = GetNormal(p1Points[i], p1Points[(i + 1)%p1Lenght], true);
+
+        if (!MinMaxCollide(GetProjectedMinMax(p1Points, p1Lenght, normal), GetProjectedMinMax(p2Points, p2Lenght, normal))) return false;
+    }
+
+    for (int i=0; i<p2Lenght; i++)
+    {
+        Vector2 normal = GetNormal(p2Points[i], p2Points[(i + 1)%p2Lenght], true);
+
+        if (!MinMaxCollide(GetProjectedMinMax(p1Points, p1Lenght, normal), GetProjectedMinMax(p2Points, p2Lenght, normal))) return false;
+    }
+
+    return true;
+}
+
+bool SATPolysNCollide (Vector2 *p1Points, Vector2 *p1Normals, int p1Lenght, Vector2 *p2Points, Vector2 *p2Normals, int p2Lenght)
+{
+    for (int i=0; i<p1Lenght; i++)
+    {
+        if (!MinMaxCollide(GetProjectedMinMax(p1Points, p1Lenght, p1Normals[i]), GetProjectedMinMax(p2Points, p2Lenght, p1Normals[i]))) return false;
+    }
+
+    for (int i=0; i<p2Lenght; i++)
+    {
+        if (!MinMaxCollide(GetProjectedMinMax(p1Points, p1Lenght, p2Normals[i]), GetProjectedMinMax(p2Points, p2Lenght, p2Normals[i]))) return false;
+    }
+
+    return true;
+}
+
+// NOTE: p2Normals must contain p2Lenght normals, p1 normals are computed
+bool SATPolyPolyNCollide (Vector2 *p1Points, int p1Lenght, Vector2 *p2Points, Vector2 *p2Normals, int p2Lenght)
+{
+    for (int i=0; i<p2Lenght; i++)
+    {
+        if (!MinMaxCollide(GetProjectedMinMax(p1Points, p1Lenght, p2Normals[i]), GetProjectedMinMax(p2Points, p2Lenght, p2Normals[i]))) return false;
+    }
+
+    for (int i=0; i<p1Lenght; i++)
+    {
+        Vector2 normal = GetNormal(p1Points[i], p1Points[(i + 1)%p1Lenght], true);
+
+        if (!MinMaxCollide(GetProjectedMinMax(p1Points, p1Lenght, normal), GetProjectedMinMax(p2Points, p2Lenght, normal))) return false;
+    }
+
+    return true;
+}
+
+bool SATPolyCircCollide (Vector2 *pPoints, Vector2 pPosition, int pLenght, Vector2 cPosition, float cRadius)
+{
+    Vector2 closest = pPoints[0];
+    float closestDistance = -1;
+    Vector2 normal;
+    float center;
+
+    for (int i=0; i<pLenght; i++)
+    {
+        float dx = pPoints[i].x - cPosition.x;
+        float dy = pPoints[i].y - cPosition.y;
+        float distance = dx*dx + dy*dy;
+
+        normal = GetNormal(pPoints[i], pPoints[(i + 1)%pLenght], true);
+        center = cPosition.x*normal.x + cPosition.y*normal.y;
+
+        if (!MinMaxCollide(GetProjectedMinMax(pPoints, pLenght, normal), (Value2){ center - cRadius, center + cRadius })) return false;
+
+        if (closestDistance < 0 || distance < closestDistance)
+        {
+            closestDistance = distance;
+            closest = pPoints[i];
+        }
+    }
+
+    // Axis from the closest polygon vertex to the circle center
+    normal = GetNormal((Vector2){ 0, 0 }, (Vector2){ cPosition.y - closest.y, closest.x - cPosition.x }, true);
+    center = cPosition.x*normal.x + cPosition.y*normal.y;
+
+    return MinMaxCollide(GetProjectedMinMax(pPoints, pLenght, normal), (Value2){ center - cRadius, center + cRadius });
+}
+
+// NOTE: If the polygon is an axis aligned box (unrotated or rotated by quarter turns) its normals are the x and y axes,
+// so only those are added (no normals computation). Projections are the same, so the results are the same than the full SAT.
+int SATPolyTrisBatchCollide (Vector2 *pPoints, int pLenght, SATTriBatch tris, Vector2 *trisNormals, unsigned char *results)
+{
+    float axesData[4][pLenght + 3];
+    BatchAxes axes = { axesData[0], axesData[1], axesData[2], axesData[3], pLenght + 3 };
+    int collisions;
+
+    if (tris.count <= 0) return 0;
+
+    for (int i=0; i<3; i++) SetBatchAxis(&axes, i, pPoints, pLenght, trisNormals[i]);
+
+    if (IsAABox(pPoints, pLenght))
+    {
+        SetBatchAxis(&axes, 3, pPoints, pLenght, (Vector2){ 1, 0 });
+        SetBatchAxis(&axes, 4, pPoints, pLenght, (Vector2){ 0, 1 });
+        axes.count = 5;
+    }
+    else
+    {
+        for (int i=0; i<pLenght; i++) SetBatchAxis(&axes, i + 3, pPoints, pLenght, GetNormal(pPoints[i], pPoints[(i + 1)%pLenght], true));
+    }
+
+#if defined(SAT_VERIFY_FAST_PATH)
+    if (axes.count < pLenght + 3)
+    {
+        unsigned char fastResults[tris.count];
+        unsigned char satResults[tris.count];
+
+        collisions = TrisBatch(axes, tris, fastResults);
+
+        for (int i=0; i<pLenght; i++) SetBatchAxis(&axes, i + 3, pPoints, pLenght, GetNormal(pPoints[i], pPoints[(i + 1)%pLenght], true));
+        axes.count = pLenght + 3;
+
+        TrisBatch(axes, tris, satResults);
+        VerifyFastPath(fastResults, satResults, tris.count);
+        if (results != NULL) for (int i=0; i<tris.count; i++) results[i] = fastResults[i];
+
+        return collisions;
+    }
+#endif
+
+    collisions = TrisBatch(axes, tris, results);
+
+    return collisions;
+}
+
+// NOTE: Boxes only have two different normals (x and y axes). If the polygon is an axis aligned box
+// they are the only separating axes, so it is an AABB test.
+int SATPolyAABoxesBatchCollide (Vector2 *pPoints, int pLenght, SATAABoxBatch boxes, unsigned char *results)
+{
+    float axesData[4][pLenght + 2];
+    BatchAxes axes = { axesData[0], axesData[1], axesData[2], axesData[3], 2 };
+    int collisions;
+
+    if (boxes.count <= 0) return 0;
+
+    SetBatchAxis(&axes, 0, pPoints, pLenght, (Vector2){ 1, 0 });
+    SetBatchAxis(&axes, 1, pPoints, pLenght, (Vector2){ 0, 1 });
+
+    if (!IsAABox(pPoints, pLenght))
+    {
+        for (int i=0; i<pLenght; i++) SetBatchAxis(&axes, i + 2, pPoints, pLenght, GetNormal(pPoints[i], pPoints[(i + 1)%pLenght], true));
+        axes.count = pLenght + 2;
+    }
+
+#if defined(SAT_VERIFY_FAST_PATH)
+    if (axes.count < pLenght + 2)
+    {
+        unsigned char fastResults[boxes.count];
+        unsigned char satResults[boxes.count];
+
+        collisions = AABoxesBatch(axes, boxes, fastResults);
+
+        for (int i=0; i<pLenght; i++) SetBatchAxis(&axes, i + 2, pPoints, pLenght, GetNormal(pPoints[i], pPoints[(i + 1)%pLenght], true));
+        axes.count = pLenght + 2;
+
+        AABoxesBatch(axes, boxes, satResults);
+        VerifyFastPath(fastResults, satResults, boxes.count);
+        if (results != NULL) for (int i=0; i<boxes.count; i++) results[i] = fastResults[i];
+
+        return collisions;
+    }
+#endif
+
+    collisions = AABoxesBatch(axes, boxes, results);
+
+    return collisions;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Checks if the points are an axis aligned box (any winding, starting on any corner)
+static bool IsAABox (Vector2 *points, int lenght)
+{
+    if (lenght != 4) return false;
+
+    return ((points[0].y == points[1].y && points[1].x == points[2].x && points[2].y == points[3].y && points[3].x == points[0].x) ||
+            (points[0].x == points[1].x && points[1].y == points[2].y && points[2].x == points[3].x && points[3].y == points[0].y));
+}
+
+static void SetBatchAxis (BatchAxes *axes, int index, Vector2 *points, int lenght, Vector2 normal)
+{
+    Value2 minMax = GetProjectedMinMax(points, lenght, normal);
+
+    axes->x[index] = normal.x;
+    axes->y[index] = normal.y;
+    axes->min[index] = minMax.a;
+    axes->max[index] = minMax.b;
+}
+
+static int TrisBatch (BatchAxes axes, SATTriBatch tris, unsigned char *results)
+{
+    int collisions = 0;
+    int end = 0;
+
+#if defined(SAT_AVX2)
+    if (IsAVX2Supported()) collisions += TrisBatchAVX2(axes, tris, &end, results);
+    else
+#endif
+#if defined(SAT_SSE2)
+    collisions += TrisBatchSSE2(axes, tris, &end, results);
+#endif
+
+    // Remaining tris (less than a SIMD step)
+    collisions += TrisBatchScalar(axes, tris, end, results);
+
+    return collisions;
+}
+
+static int AABoxesBatch (BatchAxes axes, SATAABoxBatch boxes, unsigned char *results)
+{
+    int collisions = 0;
+    int end = 0;
+
+#if defined(SAT_AVX2)
+    if (IsAVX2Supported()) collisions += AABoxesBatchAVX2(axes, boxes, &end, results);
+    else
+#endif
+#if defined(SAT_SSE2)
+    collisions += AABoxesBatchSSE2(axes, boxes, &end, results);
+#endif
+
+    collisions += AABoxesBatchScalar(axes, boxes, end, results);
+
+    return collisions;
+}
+
+#if defined(SAT_VERIFY_FAST_PATH)
+static void VerifyFastPath (unsigned char *fastResults, unsigned char *satResults, int count)
+{
+    for (int i=0; i<count; i++)
+    {
+        if (fastResults[i] != satResults[i])
+        {
+            fprintf(stderr, "SAT: fast path result (%i) differs from the full SAT (%i) on collider %i of %i\n", fastResults[i], satResults[i], i, count);
+            abort();
+        }
+    }
+}
+#endif
+
+static int TrisBatchScalar (BatchAxes axes, SATTriBatch tris, int start, unsigned char *results)
+{
+    int collisions = 0;
+
+    for (int i=start; i<tris.count; i++)
+    {
+        bool collide = true;
+
+        for (int k=0; k<axes.count && collide; k++)
+        {
+            float d0 = tris.x[0][i]*axes.x[k] + tris.y[0][i]*axes.y[k];
+            float d1 = tris.x[1][i]*axes.x[k] + tris.y[1][i]*axes.y[k];
+            float d2 = tris.x[2][i]*axes.x[k] + tris.y[2][i]*axes.y[k];
+            float min = SAT_MIN(SAT_MIN(d0, d1), d2);
+            float max = SAT_MAX(SAT_MAX(d0, d1), d2);
+
+            collide = (max >= axes.min[k] && axes.max[k] >= min);
+        }
+
+        if (results != NULL) results[i] = collide;
+        collisions += collide;
+    }
+
+    return collisions;
+}
+
+// NOTE: The box projection limits are the projection of the corner with the minimum (maximum) x and y
+// contribution, it is the same value than projecting the four corners.
+static int AABoxesBatchScalar (BatchAxes axes, SATAABoxBatch boxes, int start, unsigned char *results)
+{
+    int collisions = 0;
+
+    for (int i=start; i<boxes.count; i++)
+    {
+        bool collide = true;
+
+        for (int k=0; k<axes.count && collide; k++)
+        {
+            float min = ((axes.x[k] >= 0) ? boxes.minX[i] : boxes.maxX[i])*axes.x[k] + ((axes.y[k] >= 0) ? boxes.minY[i] : boxes.maxY[i])*axes.y[k];
+            float max = ((axes.x[k] >= 0) ? boxes.maxX[i] : boxes.minX[i])*axes.x[k] + ((axes.y[k] >= 0) ? boxes.maxY[i] : boxes.minY[i])*axes.y[k];
+
+            collide = (max >= axes.min[k] && axes.max[k] >= min);
+        }
+
+        if (results != NULL) results[i] = collide;
+        collisions += collide;
+    }
+
+    return collisions;
+}
+
+#if defined(SAT_SSE2)
+// Tests the tris 4 by 4, sets end to the first tri not tested
+static int TrisBatchSSE2 (BatchAxes axes, SATTriBatch tris, int *end, unsigned char *results)
+{
+    int collisions = 0;
+    int i;
+
+    for (i=0; i + 4 <= tris.count; i+=4)
+    {
+        __m128 x0 = _mm_loadu_ps(&tris.x[0][i]), y0 = _mm_loadu_ps(&tris.y[0][i]);
+        __m128 x1 = _mm_loadu_ps(&tris.x[1][i]), y1 = _mm_loadu_ps(&tris.y[1][i]);
+        __m128 x2 = _mm_loadu_ps(&tris.x[2][i]), y2 = _mm_loadu_ps(&tris.y[2][i]);
+        __m128 collide = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        int mask;
+
+        for (int k=0; k<axes.count; k++)
+        {
+            __m128 nx = _mm_set1_ps(axes.x[k]);
+            __m128 ny = _mm_set1_ps(axes.y[k]);
+            __m128 d0 = _mm_add_ps(_mm_mul_ps(x0, nx), _mm_mul_ps(y0, ny));
+            __m128 d1 = _mm_add_ps(_mm_mul_ps(x1, nx), _mm_mul_ps(y1, ny));
+            __m128 d2 = _mm_add_ps(_mm_mul_ps(x2, nx), _mm_mul_ps(y2, ny));
+            __m128 min = _mm_min_ps(_mm_min_ps(d0, d1), d2);
+            __m128 max = _mm_max_ps(_mm_max_ps(d0, d1), d2);
+
+            collide = _mm_and_ps(collide, _mm_and_ps(_mm_cmpge_ps(max, _mm_set1_ps(axes.min[k])), _mm_cmple_ps(min, _mm_set1_ps(axes.max[k]))));
+        }
+
+        mask = _mm_movemask_ps(collide);
+
+        for (int j=0; j<4; j++)
+        {
+            if (results != NULL) results[i + j] = (mask >> j) & 1;
+            collisions += (mask >> j) & 1;
+        }
+    }
+
+    *end = i;
+
+    return collisions;
+}
+
+static int AABoxesBatchSSE2 (BatchAxes axes, SATAABoxBatch boxes, int *end, unsigned char *results)
+{
+    int collisions = 0;
+    int i;
+
+    for (i=0; i + 4 <= boxes.count; i+=4)
+    {
+        __m128 minX = _mm_loadu_ps(&boxes.minX[i]), minY = _mm_loadu_ps(&boxes.minY[i]);
+        __m128 maxX = _mm_loadu_ps(&boxes.maxX[i]), maxY = _mm_loadu_ps(&boxes.maxY[i]);
+        __m128 collide = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        int mask;
+
+        for (int k=0; k<axes.count; k++)
+        {
+            __m128 nx = _mm_set1_ps(axes.x[k]);
+            __m128 ny = _mm_set1_ps(axes.y[k]);
+            __m128 min = _mm_add_ps(_mm_mul_ps((axes.x[k] >= 0) ? minX : maxX, nx), _mm_mul_ps((axes.y[k] >= 0) ? minY : maxY, ny));
+            __m128 max = _mm_add_ps(_mm_mul_ps((axes.x[k] >= 0) ? maxX : minX, nx), _mm_mul_ps((axes.y[k] >= 0) ? maxY : minY, ny));
+
+            collide = _mm_and_ps(collide, _mm_and_ps(_mm_cmpge_ps(max, _mm_set1_ps(axes.min[k])), _mm_cmple_ps(min, _mm_set1_ps(axes.max[k]))));
+        }
+
+        mask = _mm_movemask_ps(collide);
+
+        for (int j=0; j<4; j++)
+        {
+            if (results != NULL) results[i + j] = (mask >> j) & 1;
+            collisions += (mask >> j) & 1;
+        }
+    }
+
+    *end = i;
+
+    return collisions;
+}
+#endif
+
+#if defined(SAT_AVX2)
+// Tests the tris 8 by 8, sets end to the first tri not tested
+__attribute__((target("avx2")))
+static int TrisBatchAVX2 (BatchAxes axes, SATTriBatch tris, int *end, unsigned char *results)
+{
+    int collisions = 0;
+    int i;
+
+    for (i=0; i + 8 <= tris.count; i+=8)
+    {
+        __m256 x0 = _mm256_loadu_ps(&tris.x[0][i]), y0 = _mm256_loadu_ps(&tris.y[0][i]);
+        __m256 x1 = _mm256_loadu_ps(&tris.x[1][i]), y1 = _mm256_loadu_ps(&tris.y[1][i]);
+        __m256 x2 = _mm256_loadu_ps(&tris.x[2][i]), y2 = _mm256_loadu_ps(&tris.y[2][i]);
+        __m256 collide = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        int mask;
+
+        for (int k=0; k<axes.count; k++)
+        {
+            __m256 nx = _mm256_set1_ps(axes.x[k]);
+            __m256 ny = _mm256_set1_ps(axes.y[k]);
+            __m256 d0 = _mm256_add_ps(_mm256_mul_ps(x0, nx), _mm256_mul_ps(y0, ny));
+            __m256 d1 = _mm256_add_ps(_mm256_mul_ps(x1, nx), _mm256_mul_ps(y1, ny));
+            __m256 d2 = _mm256_add_ps(_mm256_mul_ps(x2, nx), _mm256_mul_ps(y2, ny));
+            __m256 min = _mm256_min_ps(_mm256_min_ps(d0, d1), d2);
+            __m256 max = _mm256_max_ps(_mm256_max_ps(d0, d1), d2);
+
+            collide = _mm256_and_ps(collide, _mm256_and_ps(_mm256_cmp_ps(max, _mm256_set1_ps(axes.min[k]), _CMP_GE_OQ),
+            _mm256_cmp_ps(min, _mm256_set1_ps(axes.max[k]), _CMP_LE_OQ)));
+        }
+
+        mask = _mm256_movemask_ps(collide);
+
+        for (int j=0; j<8; j++)
+        {
+            if (results != NULL) results[i + j] = (mask >> j) & 1;
+            collisions += (mask >> j) & 1;
+        }
+    }
+
+    *end = i;
+
+    return collisions;
+}
+
+__attribute__((target("avx2")))
+static int AABoxesBatchAVX2 (BatchAxes axes, SATAABoxBatch boxes, int *end, unsigned char *results)
+{
+    int collisions = 0;
+    int i;
+
+    for (i=0; i + 8 <= boxes.count; i+=8)
+    {
+        __m256 minX = _mm256_loadu_ps(&boxes.minX[i]), minY = _mm256_loadu_ps(&boxes.minY[i]);
+        __m256 maxX = _mm256_loadu_ps(&boxes.maxX[i]), maxY = _mm256_loadu_ps(&boxes.maxY[i]);
+        __m256 collide = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        int mask;
+
+        for (int k=0; k<axes.count; k++)
+        {
+            __m256 nx = _mm256_set1_ps(axes.x[k]);
+            __m256 ny = _mm256_set1_ps(axes.y[k]);
+            __m256 min = _mm256_add_ps(_mm256_mul_ps((axes.x[k] >= 0) ? minX : maxX, nx), _mm256_mul_ps((axes.y[k] >= 0) ? minY : maxY, ny));
+            __m256 max = _mm256_add_ps(_mm256_mul_ps((axes.x[k] >= 0) ? maxX : minX, nx), _mm256_mul_ps((axes.y[k] >= 0) ? maxY : minY, ny));
+
+            collide = _mm256_and_ps(collide, _mm256_and_ps(_mm256_cmp_ps(max, _mm256_set1_ps(axes.min[k]), _CMP_GE_OQ),
+            _mm256_cmp_ps(min, _mm256_set1_ps(axes.max[k]), _CMP_LE_OQ)));
+        }
+
+        mask = _mm256_movemask_ps(collide);
+
+        for (int j=0; j<8; j++)
+        {
+            if (results != NULL) results[i + j] = (mask >> j) & 1;
+            collisions += (mask >> j) & 1;
+        }
+    }
+
+    *end = i;
+
+    return collisions;
+}
+
+static bool IsAVX2Supported ()
+{
+    static int supported = -1; // Checked once
+
+    if (supported < 0) supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+
+    return (supported == 1);
+}
+#endif
@@ -73,6 +73,22 @@ typedef struct Value2
     float a;
     float b;
 }Value2;
+
+typedef struct SATTriBatch // Tris sharing the same normals, vertices laid out as structure of arrays (x[vertex][tri])
+{
+    float *x[3];
+    float *y[3];
+    int count;
+}SATTriBatch;
+
+typedef struct SATAABoxBatch // Axis aligned boxes laid out as structure of arrays
+{
+    float *minX;
+    float *minY;
+    float *maxX;
+    float *maxY;
+    int count;
+}SATAABoxBatch;
 // ----------------------------
 
 // Functions
@@ -95,6 +111,11 @@ bool SATPolysCollide (Vector2 *p1Points, int p1Lenght, Vector2 *p2Points, int p2
 bool SATPolysNCollide (Vector2 *p1Points, Vector2 *p1Normals, int p1Lenght, Vector2 *p2Points, Vector2 *p2Normals, int p2Lenght);
 bool SATPolyPolyNCollide (Vector2 *p1Points, int p1Lenght, Vector2 *p2Points, Vector2 *p2Normals, int p2Lenght);
 bool SATPolyCircCollide (Vector2 *pPoints, Vector2 pPosition, int pLenght, Vector2 cPosition, float cRadius);
+
+// One versus many collision tests (SSE2/AVX2 when available). Return the number of colliders touched by the 
+// polygon and set results[i] to 1 or 0 for each collider (results can be NULL).
+int SATPolyTrisBatchCollide (Vector2 *pPoints, int pLenght, SATTriBatch tris, Vector2 *trisNormals, unsigned char *results);
+int SATPolyAABoxesBatchCollide (Vector2 *pPoints, int pLenght, SATAABoxBatch boxes, unsigned char *results);
 // ----------------------------
 
 
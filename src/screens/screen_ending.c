@@ -25,6 +25,8 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "textcache.h"
+#include "input.h"
 
 #define MAX_CUBES 150
 #define CELL_SIZE 48
@@ -94,7 +96,7 @@ void UpdateEndingScreen(void)
     }   
     
     // Press enter to return to TITLE screen
-    if (IsKeyPressed(KEY_ENTER))
+    if (IsGameKeyPressed(KEY_ENTER))
     {
         finishScreen = 1;
     }
@@ -120,7 +122,7 @@ void DrawEndingScreen(void)
     if (cubesAmount >= MAX_CUBES)
     {
         DrawRectangleRec(playAgainBg, BLACK);
-        DrawText(playAgainText, playAgainBg.x + 2, playAgainBg.y + 2, playAgainTextSize, WHITE);        
+        DrawCachedText(playAgainText, playAgainBg.x + 2, playAgainBg.y + 2, playAgainTextSize, WHITE);        
     }
     
     DrawRectangle(5, 5, 120, 30, BLACK);
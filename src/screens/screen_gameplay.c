@@ -32,20 +32,47 @@
 #include "raylib.h"
 #include "screens.h"
 #include "satcollision.h"
+#include "particles.h"
+#include "atlas.h"
+#include "textcache.h"
+#include "input.h"
 #include "ceasings.h"
 #include "c2dmath.h"
+#include "level.h"
+#include "replay.h"
+#include "statehash.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
-#include <time.h> // RAND_MAX
+#include <time.h> // time()
 
 #define GAME_SPEED 60
 #define PLAYER_PARTICLES 60
 #define PLAYER_ONDEAD_PARTICLES 50
 #define FG_PARTICLES 20
-#define MAX_GROUND_PIECES 23
+#define PARTICLES_ARENA_SIZE 256 // Particle slots shared by all the emitters
+#define PARTICLES_BUDGET 120 // Max live particles at once (of all the emitters)
+#define PARTICLES_WORKERS 7 // Particles update threads (plus the main one)
 #define CELL_SIZE 48
 #define ASSETS_SCALE 1
+#define PLATF_SPAN_MAX_CELLS 8 // Max span collider width (cells), bounds the columns searched back for spans
+#define MAX_ZONE_DISPLACEMENT_X CELL_SIZE // Max player horizontal movement per frame (the elements camera speed, the player only moves vertically)
+#define SWEEP_STEP (CELL_SIZE/2) // Max player movement per frame checked against platforms only at its end position (faster movements are swept)
+#define EMPTY_LEVEL_WIDTH 32 // Level played when the map can't be loaded (grid cells)
+#define EMPTY_LEVEL_HEIGHT 12
+#define CHUNK_COLUMNS 16 // Grid columns pre-rendered on each level chunk texture
+#define MAX_LEVEL_CHUNKS 4 // Chunk textures ring: the visible chunks (up to 3 on a 1536 pixels wide screen) plus the next one
+#define CHUNK_MAX_HEIGHT (42*CELL_SIZE) // 2016 pixels, under the 2048 texture size supported everywhere (higher geometry is drawn per cell)
+
+// Grid columns the player "colision zone" can overlap (see GetPlayerCollisionZone), levelc checks the levels with ZONE_MAX_COLUMNS
+#if ((CELL_SIZE + 60 + MAX_ZONE_DISPLACEMENT_X + 1)/CELL_SIZE + 2) > ZONE_MAX_COLUMNS
+    #error "Player collision zone overlaps more than ZONE_MAX_COLUMNS (level.h) grid columns"
+#endif
+
+// Game objects states flags
+#define OBJECT_ACTIVE 1
+#define OBJECT_IN_SCREEN 2
 
 //----------------------------------------------------------------------------------
 // Structs Definition (local to this module)
@@ -61,6 +88,7 @@ typedef struct Transform2D
 typedef struct Camera2D
 {
     Vector2 position;
+    Vector2 prevPosition; // Previous simulation step position (drawn interpolated)
     Vector2 direction;
     Vector2 speed;
     bool isMoving;
@@ -97,90 +125,30 @@ typedef struct BoxCollider
     bool isActive;
 }BoxCollider;
 
-typedef struct TriCollider
+// Level objects of one kind, stored as parallel arrays (structure of arrays) so the culling 
+// passes only stream over the data they use. Colliders are only built for the objects on the player "colision zone".
+// NOTE: Positions are level positions and never change, cameras offset is applied when culling and drawing.
+typedef struct GameObjects
 {
-    SATTri tri;
-    bool isActive;
-}TriCollider;
-
-typedef struct ObjectStates
-{
-    bool isActive;
-    bool isInScreen;
-    bool isUp;
-}ObjectStates;
-
-typedef struct BoxGameObject
-{
-    Transform2D transform;
-    BoxCollider collider;
-    ObjectStates state;
-}BoxGameObject;
-
-typedef struct TriGameObject
-{
-    Transform2D transform;
-    TriCollider collider;
-    ObjectStates state;
-}TriGameObject;
-
-typedef struct GravityForce
-{
-    Vector2 direction;
-    float value;
-    Vector2 force;
-}GravityForce;
-
-typedef struct Particle
-{
-    Transform2D transform;
-    Vector2 direction;
-    Vector2 velocity;
-    Vector2 movementSpeed;
-    float rotationSpeed;
-    float scaleSpeed;
-    int lifeTime;
-    Color color;
-    bool isActive;
-} Particle;
-
-typedef struct SourceParticle
-{
-    float rotation[2];
-    float scale[2];
-    Vector2 direction[2];
-    Vector2 movementSpeed[2];
-    float rotationSpeed[2];
-    float scaleSpeed[2];
-    int lifeTime[2];
-    Color color;
-    Texture2D texture;
-} SourceParticle;
-
-typedef struct ParticleEmitter
-{
-    Vector2 position;
-    Vector2 offset;
-    float spawnRadius;
-    GravityForce gravity;
-    float ppf; // ParticlesPerFrame
-    float frameParticles; // Total frame particles
-    float remainingParticles; // Decimal particles left
-    int particlesAmount; // Particles that will be spawned on the current frame
-    SourceParticle source;
-    Particle *particles; // Remember to freeb
-    bool isBurst;
-    bool isActive;
-} ParticleEmitter;
+    int count;
+    float *positionX; // Level position (object center)
+    float *positionY;
+    float *halfWidth;
+    float *halfHeight;
+    unsigned char *states; // OBJECT_ACTIVE | OBJECT_IN_SCREEN
+    const unsigned int *columnOffset; // Objects on grid column x are in the range [columnOffset[x], columnOffset[x+1])
+}GameObjects;
 
 typedef struct Player
 {
     Transform2D transform;
+    Transform2D prevTransform; // Previous simulation step transform (drawn interpolated)
     DynamicObject dynamic;
     BoxCollider collider;
     Easing rotationEasing;
     bool isAlive;
     Texture2D texture;
+    Rectangle textureRec; // Sprite on the texture (atlas)
     Color color;
     ParticleEmitter pEmitter;
     SimpleEasing onDeadScaleEasing;
@@ -188,6 +156,22 @@ typedef struct Player
     ParticleEmitter onDeadPEmitter;
 }Player;
 
+// Static level geometry (tris and platfs) of CHUNK_COLUMNS grid columns, pre-rendered on a texture
+typedef struct LevelChunk
+{
+    Texture2D texture;
+    int index; // Baked chunk, columns [index*CHUNK_COLUMNS, (index + 1)*CHUNK_COLUMNS) (-1 if none)
+}LevelChunk;
+
+// Texture repeated horizontally and drawn as one quad, scrolled by its texture offset (the texture wraps on repeat)
+typedef struct TiledLayer
+{
+    Texture2D texture;
+    Vector2 position; // Screen position (top left corner)
+    float scale;
+    float parallax; // Scroll relative to the cameras movement (1 moves with the level, 0 is static)
+}TiledLayer;
+
 typedef struct Bar
 {
     Rectangle back;
@@ -216,19 +200,42 @@ static Vector2 onCameraAuxPosition;
 
 static Player player;
 
+static Atlas atlas; // Gameplay sprites (tris, platfs, player and particles)
+
 // Map variables
-static int maxTris;
-static int maxPlatfs;
+static Level level;
 
-static TriGameObject *tris;
-static Vector2 *trisSourcePosition;
+static GameObjects tris; // Column index is the mapped level data
+static SATTri *trisColliders; // Level space colliders, built on load (tris never move, rotate or scale)
+static SATTriBatch trisZone; // Colliders of the tris on the player "colision zone" (copied from trisColliders)
+static float *trisZoneData; // Zone colliders storage, sized on load for the worst-case zone (see GetZoneCapacity())
 static Vector2 triNormals[3];
-static Texture2D trisTexture;
+static Rectangle trisRec;
 
-static BoxGameObject *platfs;
-static Vector2 *platfsSourcePosition;
+static GameObjects platfs;
 static Vector2 platfNormals[2];
-static Texture2D platfsTexture;
+static Rectangle platfsRec;
+
+// Platform span colliders: contiguous platform cells merged into rectangles (collision only, platfs are still drawn per cell)
+static GameObjects platfSpans;
+static unsigned int *platfSpansColumnOffset; // Spans sorted by their first grid column
+static SATBox *platfSpansColliders; // Level space colliders, built on load
+static SATAABoxBatch platfSpansZone;
+static float *platfSpansZoneData; // minX, minY, maxX, maxY (same size than trisZoneData)
+static unsigned char *platfSpansZoneResults;
+
+// Level chunks: tris and platfs are drawn as a few big quads, baked (CPU) ahead of the camera
+static LevelChunk levelChunks[MAX_LEVEL_CHUNKS]; // Ring, chunk i is baked on levelChunks[i%MAX_LEVEL_CHUNKS]
+static int levelChunksCount; // Chunks of the whole level
+static Rectangle levelChunksBounds; // Level space (one chunk width, y and height of the level geometry, up to CHUNK_MAX_HEIGHT)
+static bool isLevelChunksHeightClamped; // Level geometry above the chunks top, drawn per cell
+static Color *chunkPixels; // Bake buffer, uploaded to the chunk texture
+static Color *trisPixels; // Sprites (CELL_SIZE x CELL_SIZE), copied from the atlas
+static Color *platfsPixels;
+
+// Grid columns range [first, last) that can be on screen for the current camera position
+static int firstVisibleColumn;
+static int lastVisibleColumn;
 
 static int attemptsCounter;
 static bool isAttemptsCounterActive;
@@ -248,11 +255,12 @@ static bool isGamePaused;
 static float mainCameraUpPercent;
 static float mainCameraDownPercent;
 
-static Texture2D bgTexture;
-static Texture2D lowBgTexture;
-
-static Vector2 lowBgsPosition[MAX_GROUND_PIECES];
+static TiledLayer bgLayer;
+static TiledLayer groundLayer;
 
+static ParticleArena particleArena;
+static unsigned int particlesSeed; // Session random seed (recorded on the replay)
+static unsigned int nextSeed; // Seed of the next session, set with SetGameplaySeed() (0: a new one)
 static ParticleEmitter fgPEmitter;
 
 static int startMessageFramesCounter;
@@ -261,6 +269,10 @@ static bool drawStartMessage;
 static Sound playerDeadSound;
 
 static float mainVolume;
+
+static Replay replay; // Input of every simulation step of the session
+static const char *replayFileName; // Replay saved on unload (NULL: not saved)
+static const char *levelFileName; // Level played instead of maps/map_02 (NULL: the game one)
 //----------------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------------
@@ -274,30 +286,58 @@ void SetPlayerAsGrounded(Player *p, int landPositionY);
 void DrawPlayer (Player p);
 void SetOnCameraPosition (Vector2 *position, Vector2 sourcePosition, Camera2D camera);
 Vector2 GetOnCameraPosition (Vector2 position, Camera2D camera);
-void UpdateOnCameraGameObject (Vector2 *position, ObjectStates *state, Vector2 sourcePosition, Camera2D elementsCamera, Camera2D camera);
-void UpdateTris (TriGameObject *tris, Vector2 *sourcePosition, Vector2 playerPosition, Camera2D camera);
-void CheckPlayerTrisCollision (Player *p, TriGameObject *tris);
-void UpdatePlatfs (BoxGameObject *platfs, Vector2 *sourcePosition, Vector2 playerPosition, Camera2D camera);
-void CheckPlayerPlatfsCollision (Player *p, BoxGameObject *platfs);
+void InitGameObjects (GameObjects *objects, int count);
+void UnloadGameObjects (GameObjects *objects);
+void SetGameObject (GameObjects *objects, int index, Vector2 position, Vector2 size);
+void ResetGameObjects (GameObjects *objects);
+void UpdateOnCameraGameObjects (GameObjects *objects, int first, int last, Camera2D elementsCamera, Camera2D camera);
+bool IsOnCollisionZone (GameObjects *objects, int index, Rectangle zone);
+int GetZoneCapacity (const unsigned int *columnOffset, int width);
+void UpdateVisibleColumns (Camera2D camera);
+void UpdateTris (Camera2D camera);
+void UpdateTrisZone (Rectangle zone);
+void GetPlayerLevelPoints (Player *p, Vector2 *points);
+Vector2 GetPlayerLevelDisplacement (Player *p);
+Rectangle GetPlayerCollisionZone (Player *p, Vector2 displacement);
+int GetPlayerSweptPoints (Vector2 *points, Vector2 displacement, Vector2 *sweptPoints);
+void CheckPlayerTrisCollision (Player *p);
+int GetPlatfSpansFirstColumn ();
+void UpdatePlatfSpans (Camera2D camera);
+void UpdatePlatfSpansZone (Rectangle zone);
+void InitLevelChunks ();
+void UnloadLevelChunks ();
+Color *LoadChunkSprite (Image atlasImage, Rectangle rec);
+void BakeLevelChunk (LevelChunk *chunk, int index);
+void DrawChunkObjects (GameObjects *objects, Color *sprite, int index);
+void UpdateLevelChunks ();
+void DrawLevelChunks (Vector2 levelCameraOffset);
+void DrawObjectsAboveChunks (GameObjects *objects, Rectangle rec, Vector2 levelCameraOffset);
+float GetSweptBoxesImpactTime (float *boxMin, float *boxMax, Vector2 displacement, float *staticMin, float *staticMax);
+void SetPlayerPlatfCollision (Player *p, int zoneIndex);
+void CheckPlayerPlatfsCollision (Player *p);
 void ResetGameplay ();
 void InitTri(int index, Vector2 coordinates, int yGridLenght);
 void InitPlatf(int index, Vector2 coordinates, int yGridLenght);
+void InitPlatfSpans();
 void LoadMap();
-bool SameColor(Color a, Color b);
 void UpdateCustomAASATTriPosition (SATTri *tri, Vector2 position);
 void UpdateCustomAASATBoxPosition (SATBox *box, Vector2 position);
-float GetRandomFloat(float min, float max);
-Vector2 GetRandomVector2(Vector2 v1, Vector2 v2);
-void UpdateParticleEmitter (ParticleEmitter *pE, int maxParticles, Vector2 position);
-void InitParticle (Particle *p, SourceParticle s, float spawnRadius, Vector2 pEPosition);
-void UpdateParticle(Particle *p, GravityForce gravity);
 void KillPlayer (Player *p);
 float CosInterpolation (float start, float end, float percent);
+void InitTiledLayer (TiledLayer *layer, const char *fileName, Vector2 position, float scale, float parallax);
+void DrawTiledLayer (TiledLayer layer, Vector2 cameraPosition);
+void SetPrevStepState ();
+Vector2 GetInterpolatedPosition (Vector2 prevPosition, Vector2 position);
+float GetInterpolatedRotation (float prevRotation, float rotation);
+void SetAttemptParticlesSeeds ();
 //----------------------------------------------------------------------------------
 
 // Gameplay Screen Initialization logic
 void InitGameplayScreen(void)
 {
+    SATTri normalsTri;
+    int zoneCapacity;
+    
     framesCounter = 0;
     finishScreen = 0;
     
@@ -351,20 +391,56 @@ void InitGameplayScreen(void)
     
     isGamePaused = false;
     
+    InitParticleArena(&particleArena, PARTICLES_ARENA_SIZE, PARTICLES_BUDGET);
+    InitParticleWorkers(PARTICLES_WORKERS);
+    
+    LoadAtlas(&atlas, "assets/gameplay/sprites.atlas"); // Packed by atlasc (see makefile)
+    
     InitPlayer(&player, (Vector2){5, 2}, (Vector2){0, 18}, 0.5f * GAME_SPEED);
+    SetPrevStepState();
     playerDeadSound = LoadSound("assets/gameplay/deadSound2.ogg");
     SetSoundVolume(playerDeadSound, mainVolume);
     
+    UpdateVisibleColumns(gameElementsCamera);
+    
     // Init Triangles
-    trisTexture = LoadTexture("assets/gameplay/tri_main.png");
-    UpdateTris(tris, trisSourcePosition, player.transform.position, gameElementsCamera); // Set them as visible if on screen
-
-    UpdateCustomAASATTriPosition(&tris[0].collider.tri, tris[0].transform.position);
-    SetNormals(tris[0].collider.tri.points, triNormals, 3, true);
+    trisRec = GetAtlasRec(&atlas, "tri_main");
+    
+    // Zone batches are sized for the densest zone of the level, so no collider in the zone is ever left untested
+    zoneCapacity = GetZoneCapacity(level.trisColumnOffset, gridLenght.x);
+    if (zoneCapacity > MAX_ZONE_COLLIDERS) fprintf(stderr, "warning: level has up to %i tris on a collision zone (levelc allows %i)\n", zoneCapacity, MAX_ZONE_COLLIDERS);
+    trisZoneData = malloc(sizeof(float) * 6 * zoneCapacity);
+    
+    for (int i=0; i<3; i++)
+    {
+        trisZone.x[i] = &trisZoneData[i * zoneCapacity];
+        trisZone.y[i] = &trisZoneData[(3 + i) * zoneCapacity];
+    }
+    
+    // Span colliders in the zone are bounded by the platf cells in the zone (every span has at least one cell there)
+    zoneCapacity = GetZoneCapacity(level.platfsColumnOffset, gridLenght.x);
+    if (zoneCapacity > MAX_ZONE_COLLIDERS) fprintf(stderr, "warning: level has up to %i platfs on a collision zone (levelc allows %i)\n", zoneCapacity, MAX_ZONE_COLLIDERS);
+    platfSpansZoneData = malloc(sizeof(float) * 4 * zoneCapacity);
+    platfSpansZoneResults = malloc(zoneCapacity);
+    
+    platfSpansZone.minX = &platfSpansZoneData[0];
+    platfSpansZone.minY = &platfSpansZoneData[zoneCapacity];
+    platfSpansZone.maxX = &platfSpansZoneData[2 * zoneCapacity];
+    platfSpansZone.maxY = &platfSpansZoneData[3 * zoneCapacity];
+    
+    // All the tris share the same normals
+    normalsTri.size = (Vector2){CELL_SIZE, CELL_SIZE};
+    UpdateCustomAASATTriPosition(&normalsTri, Vector2Zero());
+    SetNormals(normalsTri.points, triNormals, 3, true);
+    
+    UpdateTris(gameElementsCamera); // Set them as visible if on screen
     
     // Init platfsorms
-    platfsTexture = LoadTexture("assets/gameplay/platf_main.png");
-    UpdatePlatfs (platfs, platfsSourcePosition, player.transform.position, gameElementsCamera); // Set them as visible if on screen
+    // NOTE: Platfs are only drawn (baked on the level chunks), collisions use the span colliders
+    platfsRec = GetAtlasRec(&atlas, "platf_main");
+    UpdatePlatfSpans(gameElementsCamera); // Set them as visible if on screen
+    
+    InitLevelChunks();
 
     // Set AACube normals (Right/Left + Up/Down)
     platfNormals[0] = Vector2Up();
@@ -374,15 +450,10 @@ void InitGameplayScreen(void)
     progressBar.front = (Rectangle){200, 5, 0, 8};
     progressBar.isActive = true;
     
-    bgTexture = LoadTexture("assets/gameplay/bg_main.png");
-    lowBgTexture = LoadTexture("assets/gameplay/ground_main.png");
-    
-    // Init Low Bgs Position
-    for (int i=0; i<MAX_GROUND_PIECES; i++)
-    {
-        lowBgsPosition[i].y = GetScreenHeight() - lowBgTexture.height * 2;
-        lowBgsPosition[i].x = lowBgTexture.width * i;
-    }
+    // Init background layers (add more with other parallax values, they cost one quad each)
+    InitTiledLayer(&bgLayer, "assets/gameplay/bg_main.png", Vector2Zero(), 8, 0);
+    InitTiledLayer(&groundLayer, "assets/gameplay/ground_main.png", Vector2Zero(), 1, 1);
+    groundLayer.position.y = GetScreenHeight() - groundLayer.texture.height * 2;
     
     // Init fgPEmitter
     fgPEmitter.offset = Vector2Zero();
@@ -412,32 +483,43 @@ void InitGameplayScreen(void)
     fgPEmitter.source.lifeTime[0] = 4.75f * GAME_SPEED;
     fgPEmitter.source.lifeTime[1] = 5.2f * GAME_SPEED;
     fgPEmitter.source.color = WHITE;
-    fgPEmitter.source.texture = LoadTexture("assets/gameplay/glow16.png");
+    fgPEmitter.source.texture = atlas.texture;
+    fgPEmitter.source.textureRec = GetAtlasRec(&atlas, "glow16");
     
-    fgPEmitter.particles = malloc(sizeof(Particle)*FG_PARTICLES); // Remember to free
+    InitParticles(&fgPEmitter.particles, &particleArena, FG_PARTICLES, 0); // Ambient, evicted first
     fgPEmitter.isActive = true;
     
-    for (int i=0; i<FG_PARTICLES; i++)
-    {
-        fgPEmitter.particles[i].isActive = false;
-    }
+    // Set particles random streams (compile with PARTICLES_SEED defined to get the same particles on every run)
+#if defined(PARTICLES_SEED)
+    particlesSeed = PARTICLES_SEED;
+#else
+    particlesSeed = time(NULL);
+#endif
+    if (nextSeed != 0) particlesSeed = nextSeed;
+    nextSeed = 0;
+    
+    SetAttemptParticlesSeeds();
     
-    srand(time(NULL)); 
+    // Record the session input (with the seed and the level, it is simulated again with the same results)
+    InitReplay(&replay, GetLevelHash(&level), particlesSeed);
 }
 
 // Gameplay Screen Update logic
 void UpdateGameplayScreen(void)
 {   
+    SetPrevStepState();
+    RecordReplayInput(&replay, GetGameInputState());
+    
     if (isDeadFadeFinished)
     {
-        if (IsKeyPressed('P')) 
+        if (IsGameKeyPressed('P')) 
         {
             isGamePaused = !isGamePaused;
             
             if (isGamePaused) PauseMusicStream();
             else ResumeMusicStream();
         }
-        if (IsKeyPressed('R')) isDeadFadeFinished = false;
+        if (IsGameKeyPressed('R')) isDeadFadeFinished = false;
         
         if (!isGamePaused)
         {
@@ -476,37 +558,20 @@ void UpdateGameplayScreen(void)
                         progressBar.isActive = false;
                     }
                     
-                    for (int i=0; i<MAX_GROUND_PIECES; i++)
-                    {
-                        lowBgsPosition[i].x -= gameElementsCamera.speed.x;
-                    }
-                    for (int i=0; i<MAX_GROUND_PIECES; i++)
-                    {
-                        if (lowBgsPosition[i].x + lowBgTexture.width <= 0)
-                        {
-                            float aux = 0;
-                            for (int j=0; j<MAX_GROUND_PIECES; j++)
-                            {
-                                if (lowBgsPosition[j].x > aux) aux = lowBgsPosition[j].x;
-                            }
-                            lowBgsPosition[i].x = aux + lowBgTexture.width;
-                            i=MAX_GROUND_PIECES;
-                        }
-                    }
-                    
-                    UpdateParticleEmitter(&fgPEmitter, FG_PARTICLES, fgPEmitter.position);
+                    UpdateParticleEmitter(&fgPEmitter, fgPEmitter.position);
 
                     // Update game objects position before checking the collisions, so the player will see the collision drawed (otherwise it could be skiped)
-                    UpdateTris(tris, trisSourcePosition, player.transform.position, gameElementsCamera);
-                    UpdatePlatfs (platfs, platfsSourcePosition, player.transform.position, gameElementsCamera); 
+                    UpdateVisibleColumns(gameElementsCamera);
+                    UpdateTris(gameElementsCamera);
+                    UpdatePlatfSpans(gameElementsCamera);
                     UpdatePlayer(&player);
                     
                     // Check if player landed on the ground
                     if (player.transform.position.y + player.collider.box.size.y/2 >= groundY) SetPlayerAsGrounded(&player, groundY);
                     // Check if player collided with a triangle
-                    CheckPlayerTrisCollision(&player, tris);
+                    CheckPlayerTrisCollision(&player);
                     // Check if player landed (or collided) on a platfsorm.
-                    CheckPlayerPlatfsCollision(&player, platfs);
+                    CheckPlayerPlatfsCollision(&player);
                     
                     UpdateMusicStream();
                     
@@ -537,8 +602,8 @@ void UpdateGameplayScreen(void)
                         deadCounter++;
                         // TODO: Add dead explosion sound
                         
-                        UpdateParticleEmitter(&player.onDeadPEmitter, PLAYER_ONDEAD_PARTICLES, player.transform.position);
-                        UpdateParticleEmitter(&player.pEmitter, PLAYER_PARTICLES, player.transform.position);
+                        UpdateParticleEmitter(&player.onDeadPEmitter, player.transform.position);
+                        UpdateParticleEmitter(&player.pEmitter, player.transform.position);
                         
                         player.onDeadScaleEasing.t = deadCounter;
                         player.onDeadCircleSize = CubicEaseOut(player.onDeadScaleEasing.t, player.onDeadScaleEasing.b, player.onDeadScaleEasing.c, player.onDeadScaleEasing.d);
@@ -547,7 +612,7 @@ void UpdateGameplayScreen(void)
             }
             else
             {
-                if(IsKeyPressed(KEY_SPACE))
+                if(IsGameKeyPressed(KEY_SPACE))
                 {
                     // Start gameplay (first time or after player dies)
                     isGameplayStopped = false;
@@ -575,7 +640,7 @@ void UpdateGameplayScreen(void)
         {
             // If is game paused. Set music volume
             
-            if (IsKeyDown(KEY_LEFT))
+            if (IsGameKeyDown(KEY_LEFT))
             {
                 if (mainVolume > 0)
                 {
@@ -588,7 +653,7 @@ void UpdateGameplayScreen(void)
                 SetMusicVolume(mainVolume);
                 SetSoundVolume(playerDeadSound, mainVolume);
             }
-            else if (IsKeyDown(KEY_RIGHT))
+            else if (IsGameKeyDown(KEY_RIGHT))
             {
                 if (mainVolume < 1)
                 {
@@ -607,9 +672,12 @@ void UpdateGameplayScreen(void)
     {
         ResetGameplay();
     }
+    
+    // Update the particles of all the emitters updated on this frame (done before drawing them)
+    UpdateParticleArena(&particleArena);
     /*
     // Press enter to change to ENDING screen
-    if (IsKeyPressed(KEY_ENTER))
+    if (IsGameKeyPressed(KEY_ENTER))
     {
         finishScreen = 1;
     }
@@ -619,14 +687,13 @@ void UpdateGameplayScreen(void)
 // Gameplay Screen Draw logic
 void DrawGameplayScreen(void)
 {
-    // Draw BG
-    DrawTextureEx(bgTexture, (Vector2){0, 0}, 0, 8, WHITE);
+    // NOTE: Player, cameras and particles are drawn between their last two simulation steps (see GetRenderAlpha)
+    Vector2 levelCameraOffset = Vector2Add(GetInterpolatedPosition(gameElementsCamera.prevPosition, gameElementsCamera.position), 
+    GetInterpolatedPosition(mainCamera.prevPosition, mainCamera.position));
     
-    for (int i=0; i<MAX_GROUND_PIECES; i++)
-    {
-        onCameraAuxPosition = GetOnCameraPosition(lowBgsPosition[i], mainCamera);
-        DrawTextureV(lowBgTexture, onCameraAuxPosition, WHITE);
-    }
+    // Draw BG and ground (scrolled with the cameras)
+    DrawTiledLayer(bgLayer, levelCameraOffset);
+    DrawTiledLayer(groundLayer, levelCameraOffset);
     
     // Draw Ground
     //DrawRectangle(0, GetOnCameraPosition((Vector2){0, groundY}, mainCamera).y, GetScreenWidth(), 2, BLACK);
@@ -635,82 +702,49 @@ void DrawGameplayScreen(void)
     //for (int i=0; i<gridLenght.x+1; i++) DrawRectangle(i*CELL_SIZE, 0, 1, GetScreenHeight(), LIGHTGRAY); // Columns
     //for (int i=0; i<gridLenght.y; i++) DrawRectangle(0, i*CELL_SIZE, GetScreenWidth(), 1, LIGHTGRAY); // Rows
     
-    // Draw Tris
-    for (int i=0; i<maxTris; i++)
+    // Draw Tris and Platfs (baked on the level chunks)
+    // NOTE: Level objects are on level space, both cameras offset is applied here
+    DrawLevelChunks(levelCameraOffset);
+    
+    /*
+    // Debug collision points
+    for (int i=0; i<trisZone.count; i++)
     {
-        if(tris[i].state.isInScreen) 
-        {
-            onCameraAuxPosition = GetOnCameraPosition(tris[i].transform.position, mainCamera);
-            
-            DrawTexturePro(trisTexture, (Rectangle){0, 0, CELL_SIZE, CELL_SIZE}, (Rectangle){onCameraAuxPosition.x, 
-            onCameraAuxPosition.y, CELL_SIZE, CELL_SIZE}, (Vector2){CELL_SIZE/2, CELL_SIZE/2}, 
-            tris[i].transform.rotation, WHITE);
-            
-            /*
-            // Debug collision points
-            for (int j=0; j<3; j++)
-            {
-                onCameraAuxPosition = GetOnCameraPosition(tris[i].collider.tri.points[j], mainCamera);
-                if (tris[i].collider.isActive) DrawCircleV(onCameraAuxPosition, 5, GREEN);
-            }
-            */
-        }
+        for (int j=0; j<3; j++) DrawCircleV(Vector2Sub((Vector2){trisZone.x[j][i], trisZone.y[j][i]}, levelCameraOffset), 5, GREEN);
     }
+    */
     
-    for (int i=0; i<maxPlatfs; i++)
+    /*
+    // Debug collision points
+    for (int i=0; i<platfSpansZone.count; i++)
     {
-        if(platfs[i].state.isInScreen) 
-        {
-            onCameraAuxPosition = GetOnCameraPosition(platfs[i].transform.position, mainCamera);
-            
-            DrawTexturePro(platfsTexture, (Rectangle){0, 0, CELL_SIZE, CELL_SIZE}, (Rectangle){onCameraAuxPosition.x, 
-            onCameraAuxPosition.y, CELL_SIZE, CELL_SIZE}, (Vector2){CELL_SIZE/2, CELL_SIZE/2}, 
-            platfs[i].transform.rotation, WHITE);
-            
-            /*
-            // Debug collision points
-            for (int j=0; j<4; j++)
-            {
-                onCameraAuxPosition = GetOnCameraPosition(platfs[i].collider.box.points[j], mainCamera);
-                if (platfs[i].collider.isActive) DrawCircleV(onCameraAuxPosition, 5, GREEN);
-            }
-            */
-        }
+        DrawRectangleLines(platfSpansZone.minX[i] - levelCameraOffset.x, platfSpansZone.minY[i] - levelCameraOffset.y, 
+        platfSpansZone.maxX[i] - platfSpansZone.minX[i], platfSpansZone.maxY[i] - platfSpansZone.minY[i], GREEN);
     }
+    */
     
-    if (isAttemptsCounterActive) DrawText(FormatText("%i", attemptsCounter), attemptsCounterPosition.x, attemptsCounterPosition.y, 200, WHITE);
+    if (isAttemptsCounterActive) DrawCachedText(FormatText("%i", attemptsCounter), attemptsCounterPosition.x, attemptsCounterPosition.y, 200, WHITE);
     
     DrawPlayer(player);
    
-    for (int i=0; i<FG_PARTICLES; i++)
-    {
-        if (fgPEmitter.particles[i].isActive)
-        {
-            //onCameraAuxPosition = GetOnCameraPosition(fgPEmitter.particles[i].transform.position, mainCamera);
-            
-            DrawTexturePro(fgPEmitter.source.texture, (Rectangle){0, 0, fgPEmitter.source.texture.width, fgPEmitter.source.texture.height}, 
-            (Rectangle){fgPEmitter.particles[i].transform.position.x, fgPEmitter.particles[i].transform.position.y, fgPEmitter.source.texture.width * fgPEmitter.particles[i].transform.scale, 
-            fgPEmitter.source.texture.height * fgPEmitter.particles[i].transform.scale}, (Vector2){fgPEmitter.source.texture.width/2, fgPEmitter.source.texture.height/2}, 
-            -fgPEmitter.particles[i].transform.rotation, fgPEmitter.particles[i].color);
-        }
-    }
+    DrawParticles(&fgPEmitter.particles, fgPEmitter.source.texture, fgPEmitter.source.textureRec, Vector2Zero(), fgPEmitter.source.color, false, GetRenderAlpha());
     
     DrawRectangleRec(progressBar.back, LIGHTGRAY);
     DrawRectangleRec(progressBar.front, RED);
     
-    if (isGameplayStopped && drawStartMessage) DrawText("PRESS SPACE!!!", 10, GetScreenHeight()-30, 20, BLACK);
+    if (isGameplayStopped && drawStartMessage) DrawCachedText("PRESS SPACE!!!", 10, GetScreenHeight()-30, 20, BLACK);
     
     if (isGamePaused)
     {
         DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(LIGHTGRAY, 0.45f));
-        DrawText("PAUSE", GetScreenWidth()/2 - 100, GetScreenHeight()/2-20, 40, WHITE);
-        DrawText("<P>", GetScreenWidth()/2 - 45, GetScreenHeight()/2 + 30, 24, WHITE); 
+        DrawCachedText("PAUSE", GetScreenWidth()/2 - 100, GetScreenHeight()/2-20, 40, WHITE);
+        DrawCachedText("<P>", GetScreenWidth()/2 - 45, GetScreenHeight()/2 + 30, 24, WHITE); 
         
-        DrawText("Set volume using arrow keys.", 325, GetScreenHeight() - 50, 20, BLACK);
-        DrawText("Volume: ", 415, GetScreenHeight() - 25, 20, BLACK);
-        DrawText("<", 500, GetScreenHeight() - 25, 20, BLACK);
-        DrawText(FormatText("%02.0f", mainVolume * 100), 515, GetScreenHeight() - 25, 20, BLACK);
-        DrawText(">", 548, GetScreenHeight() - 25, 20, BLACK);
+        DrawCachedText("Set volume using arrow keys.", 325, GetScreenHeight() - 50, 20, BLACK);
+        DrawCachedText("Volume: ", 415, GetScreenHeight() - 25, 20, BLACK);
+        DrawCachedText("<", 500, GetScreenHeight() - 25, 20, BLACK);
+        DrawCachedText(FormatText("%02.0f", mainVolume * 100), 515, GetScreenHeight() - 25, 20, BLACK);
+        DrawCachedText(">", 548, GetScreenHeight() - 25, 20, BLACK);
     }
 
     if (!isDeadFadeFinished)
@@ -722,24 +756,28 @@ void DrawGameplayScreen(void)
 // Gameplay Screen Unload logic
 void UnloadGameplayScreen(void)
 {
-    free(tris);
-    free(platfs);
-    free(trisSourcePosition);
-    free(platfsSourcePosition);
-    free(player.pEmitter.particles);
-    free(player.onDeadPEmitter.particles);
-    free(fgPEmitter.particles);
-    
-    UnloadTexture(player.texture);
-    UnloadTexture(trisTexture);
-    UnloadTexture(platfsTexture);
-    UnloadTexture(player.pEmitter.source.texture);
-    UnloadTexture(player.onDeadPEmitter.source.texture);
-    UnloadTexture(fgPEmitter.source.texture);
-    UnloadTexture(bgTexture);
-    UnloadTexture(lowBgTexture);
+    UnloadGameObjects(&tris);
+    UnloadGameObjects(&platfs);
+    UnloadGameObjects(&platfSpans);
+    free(trisColliders);
+    free(platfSpansColliders);
+    free(platfSpansColumnOffset);
+    free(trisZoneData);
+    free(platfSpansZoneData);
+    free(platfSpansZoneResults);
+    UnloadLevel(&level);
+    CloseParticleWorkers();
+    UnloadParticleArena(&particleArena);
+    
+    UnloadAtlas(&atlas);
+    UnloadLevelChunks();
+    UnloadTexture(bgLayer.texture);
+    UnloadTexture(groundLayer.texture);
     
     UnloadSound(playerDeadSound);
+    
+    if (replayFileName != NULL) SaveReplay(&replay, replayFileName);
+    UnloadReplay(&replay);
 }
 
 // Gameplay Screen should finish?
@@ -748,6 +786,81 @@ int FinishGameplayScreen(void)
     return finishScreen;
 }
 
+// Gameplay simulation state (read by the headless runs)
+int IsGameplayPlayerAlive(void)
+{
+    return player.isAlive;
+}
+
+int GetGameplayAttempts(void)
+{
+    return attemptsCounter;
+}
+
+// Random seed of the next gameplay session (replays), call before InitGameplayScreen
+void SetGameplaySeed(unsigned int seed)
+{
+    nextSeed = seed;
+}
+
+void SetGameplayReplayFile(const char *fileName)
+{
+    replayFileName = fileName;
+}
+
+// Compiled level of the next gameplay session (headless benchmarks), call before InitGameplayScreen
+void SetGameplayLevelFile(const char *fileName)
+{
+    levelFileName = fileName;
+}
+
+unsigned long long GetGameplayLevelHash(void)
+{
+    return replay.levelHash;
+}
+
+unsigned int GetGameplaySeed(void)
+{
+    return particlesSeed;
+}
+
+// Hash of the state that the next steps depend on (player, cameras, level objects flags and particles random streams
+// and counts), cheap enough to be computed on every step (level objects are one byte each)
+// NOTE: Structs are hashed member by member (bools widened to int), their padding bytes are never hashed
+// NOTE: Particles positions, speeds and scales are only drawn (never read by the simulation), so they are not hashed
+unsigned long long GetGameplayStateHash(void)
+{
+    unsigned long long hash = STATE_HASH_BASIS;
+    float playerValues[18] = { player.transform.position.x, player.transform.position.y, player.transform.rotation, player.transform.scale,
+                               player.dynamic.prevPosition.x, player.dynamic.prevPosition.y, player.dynamic.direction.x, player.dynamic.direction.y,
+                               player.dynamic.speed.x, player.dynamic.speed.y, player.dynamic.velocity.x, player.dynamic.velocity.y,
+                               player.rotationEasing.t, player.rotationEasing.b, player.rotationEasing.c[0], player.rotationEasing.c[1],
+                               player.rotationEasing.d[0], player.rotationEasing.d[1] };
+    float camerasValues[16] = { gameElementsCamera.position.x, gameElementsCamera.position.y, gameElementsCamera.prevPosition.x, gameElementsCamera.prevPosition.y,
+                                gameElementsCamera.direction.x, gameElementsCamera.direction.y, gameElementsCamera.speed.x, gameElementsCamera.speed.y,
+                                mainCamera.position.x, mainCamera.position.y, mainCamera.prevPosition.x, mainCamera.prevPosition.y,
+                                mainCamera.direction.x, mainCamera.direction.y, mainCamera.speed.x, mainCamera.speed.y };
+    int flags[7] = { player.dynamic.isGrounded, player.dynamic.isJumping, player.dynamic.isFalling, player.isAlive, player.rotationEasing.isFinished,
+                     gameElementsCamera.isMoving, mainCamera.isMoving };
+    int counters[6] = { attemptsCounter, deadCounter, isGameplayStopped, isGamePaused, isDeadFadeFinished, finishScreen };
+    int particlesCounts[4] = { player.pEmitter.particles.activeCount, player.onDeadPEmitter.particles.activeCount, fgPEmitter.particles.activeCount, particleArena.activeCount };
+    
+    hash = HashStateData(hash, playerValues, sizeof(playerValues));
+    hash = HashStateData(hash, camerasValues, sizeof(camerasValues));
+    hash = HashStateData(hash, flags, sizeof(flags));
+    hash = HashStateData(hash, counters, sizeof(counters));
+    
+    hash = HashStateData(hash, tris.states, tris.count);
+    hash = HashStateData(hash, platfSpans.states, platfSpans.count);
+    
+    hash = HashStateData(hash, player.pEmitter.particles.random, sizeof(player.pEmitter.particles.random));
+    hash = HashStateData(hash, player.onDeadPEmitter.particles.random, sizeof(player.onDeadPEmitter.particles.random));
+    hash = HashStateData(hash, fgPEmitter.particles.random, sizeof(fgPEmitter.particles.random));
+    hash = HashStateData(hash, particlesCounts, sizeof(particlesCounts));
+    
+    return hash;
+}
+
 // Returns the position (cell center) based on the coordinates over the current grid
 Vector2 GetOnGridPosition(Vector2 coordinates)
 {
@@ -784,13 +897,14 @@ void InitPlayer(Player *p, Vector2 coordinates, Vector2 speed, float rotationSpa
     p->dynamic.isFalling = false;
     
     //Set player texture
-    p->texture = LoadTexture("assets/gameplay/character/main_cube.png");
+    p->texture = atlas.texture;
+    p->textureRec = GetAtlasRec(&atlas, "main_cube");
     
     // Set p color
     p->color = WHITE;
     
-    // Init p boxCollider
-    InitSATBox(&p->collider.box, p->transform.position, (Vector2){p->texture.width, p->texture.height}, p->transform.rotation);
+    // Init p boxCollider (cell size, the same as the drawn sprite, so collisions don't depend on the loaded textures)
+    InitSATBox(&p->collider.box, p->transform.position, (Vector2){CELL_SIZE, CELL_SIZE}, p->transform.rotation);
     
     // Init easing
     p->rotationEasing.t = 0;
@@ -830,15 +944,11 @@ void InitPlayer(Player *p, Vector2 coordinates, Vector2 speed, float rotationSpa
     p->pEmitter.source.lifeTime[0] = 0.9f * GAME_SPEED;
     p->pEmitter.source.lifeTime[1] = 1.2f * GAME_SPEED;
     p->pEmitter.source.color = (Color){40, 255, 40, 255};
-    p->pEmitter.source.texture = LoadTexture("assets/gameplay/particle_main.png");
+    p->pEmitter.source.texture = atlas.texture;
+    p->pEmitter.source.textureRec = GetAtlasRec(&atlas, "particle_main");
     
-    p->pEmitter.particles = malloc(sizeof(Particle)*PLAYER_PARTICLES); // Remember to free
+    InitParticles(&p->pEmitter.particles, &particleArena, PLAYER_PARTICLES, 1); // Trail, evicted before the dead burst
     p->pEmitter.isActive = true;
-    
-    for (int i=0; i<PLAYER_PARTICLES; i++)
-    {
-        p->pEmitter.particles[i].isActive = false;
-    }
 
     p->onDeadPEmitter.offset = (Vector2){-CELL_SIZE/2, 0};
     p->onDeadPEmitter.position = Vector2Add(p->transform.position, p->onDeadPEmitter.offset);
@@ -867,16 +977,12 @@ void InitPlayer(Player *p, Vector2 coordinates, Vector2 speed, float rotationSpa
     p->onDeadPEmitter.source.lifeTime[0] = deadSpan;
     p->onDeadPEmitter.source.lifeTime[1] = deadSpan;
     p->onDeadPEmitter.source.color = (Color){255, 255, 0, 255};
-    p->onDeadPEmitter.source.texture = LoadTexture("assets/gameplay/glow16.png");
+    p->onDeadPEmitter.source.texture = atlas.texture;
+    p->onDeadPEmitter.source.textureRec = GetAtlasRec(&atlas, "glow16");
     
-    p->onDeadPEmitter.particles = malloc(sizeof(Particle)*PLAYER_ONDEAD_PARTICLES); // Remember to free
+    InitParticles(&p->onDeadPEmitter.particles, &particleArena, PLAYER_ONDEAD_PARTICLES, 2); // Dead burst, never evicted
     p->onDeadPEmitter.isActive = false;
     
-    for (int i=0; i<PLAYER_ONDEAD_PARTICLES; i++)
-    {
-        p->onDeadPEmitter.particles[i].isActive = false;
-    }
-    
     p->onDeadScaleEasing.isFinished = true;
     p->onDeadScaleEasing.t = 0;
     p->onDeadScaleEasing.b = 1;
@@ -904,7 +1010,7 @@ void UpdatePlayer(Player *p)
     else
     {
         // Check jump key
-        if (IsKeyDown(KEY_SPACE)) 
+        if (IsGameKeyDown(KEY_SPACE)) 
         {
             p->dynamic.isGrounded = false;
             p->dynamic.isJumping = true;
@@ -946,7 +1052,7 @@ void UpdatePlayer(Player *p)
     // Set player isGrounded to false since it has to be checked every frame
     p->dynamic.isGrounded = false; 
     
-    UpdateParticleEmitter(&p->pEmitter, PLAYER_PARTICLES, p->transform.position);
+    UpdateParticleEmitter(&p->pEmitter, p->transform.position);
 }
 
 void SetPlayerAsGrounded(Player *p, int landPositionY)
@@ -972,165 +1078,562 @@ void SetPlayerAsGrounded(Player *p, int landPositionY)
 
 void DrawPlayer (Player p)
 {
+    Vector2 cameraPosition = GetInterpolatedPosition(mainCamera.prevPosition, mainCamera.position);
+    
     if (p.isAlive)
     {
-        onCameraAuxPosition = GetOnCameraPosition(p.transform.position, mainCamera);
+        onCameraAuxPosition = Vector2Sub(GetInterpolatedPosition(p.prevTransform.position, p.transform.position), cameraPosition);
         
-        DrawTexturePro(p.texture, (Rectangle){0, 0, CELL_SIZE, CELL_SIZE}, (Rectangle){onCameraAuxPosition.x, 
+        DrawTexturePro(p.texture, (Rectangle){p.textureRec.x, p.textureRec.y, CELL_SIZE, CELL_SIZE}, (Rectangle){onCameraAuxPosition.x, 
         onCameraAuxPosition.y, CELL_SIZE, CELL_SIZE}, (Vector2){CELL_SIZE/2, 
-        CELL_SIZE/2}, -p.transform.rotation, p.color);
+        CELL_SIZE/2}, -GetInterpolatedRotation(p.prevTransform.rotation, p.transform.rotation), p.color);
     }
     else
     {
-        onCameraAuxPosition = GetOnCameraPosition(p.transform.position, mainCamera);
+        onCameraAuxPosition = Vector2Sub(GetInterpolatedPosition(p.prevTransform.position, p.transform.position), cameraPosition);
         //DrawCircleV(onCameraAuxPosition, p.onDeadCircleSize, Fade(BLUE, 0.4f));
         
-        for (int i=0; i<PLAYER_ONDEAD_PARTICLES; i++)
+        DrawParticles(&p.onDeadPEmitter.particles, p.onDeadPEmitter.source.texture, p.onDeadPEmitter.source.textureRec, cameraPosition, p.onDeadPEmitter.source.color, true, GetRenderAlpha());
+    }
+    
+    DrawParticles(&p.pEmitter.particles, p.pEmitter.source.texture, p.pEmitter.source.textureRec, cameraPosition, p.pEmitter.source.color, false, GetRenderAlpha());
+}
+
+void SetOnCameraPosition (Vector2 *position, Vector2 sourcePosition, Camera2D camera)
+{
+    *position = Vector2Sub(sourcePosition, camera.position);
+}
+
+Vector2 GetOnCameraPosition (Vector2 position, Camera2D camera)
+{
+    return Vector2Sub(position, camera.position);
+}
+
+void InitGameObjects (GameObjects *objects, int count)
+{
+    // Remember to free (UnloadGameObjects)
+    objects->count = count;
+    objects->positionX = malloc(sizeof(float) * count);
+    objects->positionY = malloc(sizeof(float) * count);
+    objects->halfWidth = malloc(sizeof(float) * count);
+    objects->halfHeight = malloc(sizeof(float) * count);
+    objects->states = malloc(sizeof(unsigned char) * count);
+    objects->columnOffset = NULL;
+}
+
+void UnloadGameObjects (GameObjects *objects)
+{
+    free(objects->positionX);
+    free(objects->positionY);
+    free(objects->halfWidth);
+    free(objects->halfHeight);
+    free(objects->states);
+    objects->count = 0;
+}
+
+void SetGameObject (GameObjects *objects, int index, Vector2 position, Vector2 size)
+{
+    objects->positionX[index] = position.x;
+    objects->positionY[index] = position.y;
+    objects->halfWidth[index] = size.x/2;
+    objects->halfHeight[index] = size.y/2;
+    objects->states[index] = OBJECT_ACTIVE;
+}
+
+void ResetGameObjects (GameObjects *objects)
+{
+    memset(objects->states, OBJECT_ACTIVE, objects->count);
+}
+
+// Updates the screen states of the objects in the range [first, last), positions are not modified
+void UpdateOnCameraGameObjects (GameObjects *objects, int first, int last, Camera2D elementsCamera, Camera2D camera)
+{
+    // Screen limits on level space
+    const float left = elementsCamera.position.x;
+    const float right = left + GetScreenWidth();
+    const float top = elementsCamera.position.y + camera.position.y;
+    const float bottom = top + GetScreenHeight();
+    
+    for (int i=first; i<last; i++)
+    {
+        if (objects->states[i] & OBJECT_ACTIVE)
         {
-            if (p.onDeadPEmitter.particles[i].isActive)
+            // Set object un-active if leaves the screen (from left)
+            if (objects->positionX[i] + objects->halfWidth[i] < left) objects->states[i] = 0;
+            else if (objects->positionX[i] - objects->halfWidth[i] < right && objects->positionY[i] + objects->halfHeight[i] > top && 
+            objects->positionY[i] - objects->halfHeight[i] < bottom)
             {
-                onCameraAuxPosition = GetOnCameraPosition(p.onDeadPEmitter.particles[i].transform.position, mainCamera);
-                
-                DrawTexturePro(p.onDeadPEmitter.source.texture, (Rectangle){0, 0, p.onDeadPEmitter.source.texture.width, p.onDeadPEmitter.source.texture.height}, 
-                (Rectangle){onCameraAuxPosition.x, onCameraAuxPosition.y, p.onDeadPEmitter.source.texture.width * p.onDeadPEmitter.particles[i].transform.scale, 
-                p.onDeadPEmitter.source.texture.height * p.onDeadPEmitter.particles[i].transform.scale}, (Vector2){p.onDeadPEmitter.source.texture.width * p.onDeadPEmitter.particles[i].transform.scale/2, 
-                p.onDeadPEmitter.source.texture.height * p.onDeadPEmitter.particles[i].transform.scale/2}, 
-                -p.onDeadPEmitter.particles[i].transform.rotation, p.onDeadPEmitter.particles[i].color);
+                objects->states[i] = OBJECT_ACTIVE | OBJECT_IN_SCREEN;
             }
+            else objects->states[i] = OBJECT_ACTIVE;
         }
     }
+}
+
+// Checks if an object overlaps the player "colision zone" (level space rectangle)
+bool IsOnCollisionZone (GameObjects *objects, int index, Rectangle zone)
+{
+    return CheckCollisionRecs(zone, (Rectangle){objects->positionX[index] - objects->halfWidth[index], objects->positionY[index] - objects->halfHeight[index], 
+    objects->halfWidth[index]*2, objects->halfHeight[index]*2});
+}
+
+// Max objects on ZONE_MAX_COLUMNS consecutive grid columns: the most colliders a player "colision zone" can hold
+int GetZoneCapacity (const unsigned int *columnOffset, int width)
+{
+    int capacity = 1;
+    
+    for (int x=0; x<width; x++)
+    {
+        int lastColumn = (x + ZONE_MAX_COLUMNS < width) ? x + ZONE_MAX_COLUMNS : width;
+        int count = columnOffset[lastColumn] - columnOffset[x];
+        
+        if (count > capacity) capacity = count;
+    }
+    
+    return capacity;
+}
+
+// Sets the grid columns that can be seen from the camera. One extra column is kept on the left side,
+// so objects leaving the screen are still updated (set as un-active) on the frame they leave it.
+void UpdateVisibleColumns (Camera2D camera)
+{
+    firstVisibleColumn = camera.position.x/CELL_SIZE - 1;
+    lastVisibleColumn = (camera.position.x + GetScreenWidth())/CELL_SIZE + 1;
+    
+    if (firstVisibleColumn < 0) firstVisibleColumn = 0;
+    else if (firstVisibleColumn > gridLenght.x) firstVisibleColumn = gridLenght.x;
+    
+    if (lastVisibleColumn < firstVisibleColumn) lastVisibleColumn = firstVisibleColumn;
+    else if (lastVisibleColumn > gridLenght.x) lastVisibleColumn = gridLenght.x;
+}
+
+void UpdateTris (Camera2D camera)
+{
+    UpdateOnCameraGameObjects(&tris, tris.columnOffset[firstVisibleColumn], tris.columnOffset[lastVisibleColumn], camera, mainCamera);
+}
+
+// Builds the colliders of the tris on the player "colision zone"
+void UpdateTrisZone (Rectangle zone)
+{
+    trisZone.count = 0;
     
-    for (int i=0; i<PLAYER_PARTICLES; i++)
+    for (int i=tris.columnOffset[firstVisibleColumn]; i<tris.columnOffset[lastVisibleColumn]; i++)
     {
-        if (p.pEmitter.particles[i].isActive)
+        if ((tris.states[i] & OBJECT_IN_SCREEN) && IsOnCollisionZone(&tris, i, zone))
         {
-            onCameraAuxPosition = GetOnCameraPosition(p.pEmitter.particles[i].transform.position, mainCamera);
+            for (int j=0; j<3; j++)
+            {
+                trisZone.x[j][trisZone.count] = trisColliders[i].points[j].x;
+                trisZone.y[j][trisZone.count] = trisColliders[i].points[j].y;
+            }
             
-            DrawTexturePro(p.pEmitter.source.texture, (Rectangle){0, 0, p.pEmitter.source.texture.width, p.pEmitter.source.texture.height}, 
-            (Rectangle){onCameraAuxPosition.x, onCameraAuxPosition.y, p.pEmitter.source.texture.width * p.pEmitter.particles[i].transform.scale, 
-            p.pEmitter.source.texture.height * p.pEmitter.particles[i].transform.scale}, (Vector2){p.pEmitter.source.texture.width/2, p.pEmitter.source.texture.height/2}, 
-            -p.pEmitter.particles[i].transform.rotation, p.pEmitter.particles[i].color);
+            trisZone.count++;
         }
     }
 }
 
-void SetOnCameraPosition (Vector2 *position, Vector2 sourcePosition, Camera2D camera)
+// Moves the player collider points to level space (obstacle colliders are already there)
+void GetPlayerLevelPoints (Player *p, Vector2 *points)
 {
-    *position = Vector2Sub(sourcePosition, camera.position);
+    for (int i=0; i<4; i++) points[i] = Vector2Add(p->collider.box.points[i], gameElementsCamera.position);
 }
 
-Vector2 GetOnCameraPosition (Vector2 position, Camera2D camera)
+// Player movement on level space on the current frame (its own movement plus the elements camera movement)
+Vector2 GetPlayerLevelDisplacement (Player *p)
 {
-    return Vector2Sub(position, camera.position);
+    return Vector2Add(Vector2Sub(p->transform.position, p->dynamic.prevPosition), Vector2Product(gameElementsCamera.direction, gameElementsCamera.speed));
 }
 
-void UpdateOnCameraGameObject (Vector2 *position, ObjectStates *state, Vector2 sourcePosition, Camera2D elementsCamera, Camera2D camera)
+// Player "colision zone": the player cell (plus a margin) swept from its previous position to the current one
+Rectangle GetPlayerCollisionZone (Player *p, Vector2 displacement)
 {
-    SetOnCameraPosition(position, sourcePosition, elementsCamera);
-    onCameraAuxPosition = GetOnCameraPosition(*position, camera);
+    Vector2 position = Vector2Add(p->transform.position, gameElementsCamera.position);
+    Rectangle zone = {position.x - (CELL_SIZE/2 + 30), position.y - (CELL_SIZE/2 + 30), CELL_SIZE + 60, CELL_SIZE + 60};
+    
+    if (displacement.x > 0) zone.x -= displacement.x;
+    if (displacement.y > 0) zone.y -= displacement.y;
+    zone.width += fabsf(displacement.x) + 1;
+    zone.height += fabsf(displacement.y) + 1;
+    
+    return zone;
+}
 
-    // Set object un-active if leaves the screen (from left)
-    if (position->x + CELL_SIZE/2 < 0) 
+// Convex hull of the player collider on its previous and current positions (the area it swept on the frame, as it only
+// moves, it never rotates, between both), up to 8 points. Returns the points count (sweptPoints needs room for 16).
+// NOTE: Monotone chain, collinear points are dropped (so the batch SAT never gets null edges)
+int GetPlayerSweptPoints (Vector2 *points, Vector2 displacement, Vector2 *sweptPoints)
+{
+    Vector2 sorted[8];
+    int count = 0;
+    
+    // Sorted by x (then y)
+    for (int i=0; i<8; i++)
     {
-        state->isInScreen = false;
-        state->isActive = false;
+        Vector2 point = (i < 4) ? points[i] : Vector2Sub(points[i - 4], displacement);
+        int j = i;
+        
+        while (j > 0 && (sorted[j - 1].x > point.x || (sorted[j - 1].x == point.x && sorted[j - 1].y > point.y)))
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        
+        sorted[j] = point;
+    }
+    
+    // Lower chain forward and upper chain backward, each one without its last point (the next chain first one)
+    for (int pass=0; pass<2; pass++)
+    {
+        int chainStart = count;
+        
+        for (int k=0; k<8; k++)
+        {
+            Vector2 point = (pass == 0) ? sorted[k] : sorted[7 - k];
+            
+            while (count >= chainStart + 2)
+            {
+                Vector2 a = sweptPoints[count - 2];
+                Vector2 b = sweptPoints[count - 1];
+                
+                if ((b.x - a.x)*(point.y - a.y) - (b.y - a.y)*(point.x - a.x) > 0) break;
+                count--;
+            }
+            
+            sweptPoints[count++] = point;
+        }
+        
+        count--;
     }
-    else if (position->x - CELL_SIZE/2 < GetScreenWidth() && onCameraAuxPosition.y + CELL_SIZE/2 > 0 && onCameraAuxPosition.y - CELL_SIZE/2 < GetScreenHeight())
+    
+    return count;
+}
+
+// The whole swept area is tested (not only sampled positions), so the player can't pass through any tri part
+void CheckPlayerTrisCollision (Player *p)
+{
+    Vector2 playerPoints[4];
+    Vector2 sweptPoints[16]; // Chains in progress can hold up to twice the hull points
+    Vector2 displacement = GetPlayerLevelDisplacement(p);
+    int collisions;
+    
+    GetPlayerLevelPoints(p, playerPoints);
+    UpdateTrisZone(GetPlayerCollisionZone(p, displacement));
+    
+    if (displacement.x == 0 && displacement.y == 0) collisions = SATPolyTrisBatchCollide(playerPoints, 4, trisZone, triNormals, NULL);
+    else collisions = SATPolyTrisBatchCollide(sweptPoints, GetPlayerSweptPoints(playerPoints, displacement, sweptPoints), trisZone, triNormals, NULL);
+    
+    if (collisions > 0)
     {
-        state->isInScreen = true;
+        // Player collided with a triangle
+        // Set player as dead
+        KillPlayer(p);
     }
-    else state->isInScreen = false;
+}
 
+// Spans starting up to PLATF_SPAN_MAX_CELLS-1 columns before the visible ones can still reach the screen
+int GetPlatfSpansFirstColumn ()
+{
+    int firstColumn = firstVisibleColumn - (PLATF_SPAN_MAX_CELLS - 1);
+    
+    if (firstColumn < 0) firstColumn = 0;
+    
+    return firstColumn;
+}
+
+void UpdatePlatfSpans (Camera2D camera)
+{
+    UpdateOnCameraGameObjects(&platfSpans, platfSpans.columnOffset[GetPlatfSpansFirstColumn()], platfSpans.columnOffset[lastVisibleColumn], camera, mainCamera);
 }
 
-void UpdateTris (TriGameObject *tris, Vector2 *sourcePosition, Vector2 playerPosition, Camera2D camera)
+// Builds the colliders of the spans on the player "colision zone"
+void UpdatePlatfSpansZone (Rectangle zone)
 {
-    for (int i=0; i<maxTris; i++)
+    platfSpansZone.count = 0;
+    
+    for (int i=platfSpans.columnOffset[GetPlatfSpansFirstColumn()]; i<platfSpans.columnOffset[lastVisibleColumn]; i++)
     {
-        if (tris[i].state.isActive)
+        if ((platfSpans.states[i] & OBJECT_IN_SCREEN) && IsOnCollisionZone(&platfSpans, i, zone))
         {
-            UpdateOnCameraGameObject(&tris[i].transform.position, &tris[i].state, sourcePosition[i], camera, mainCamera);
-            
-            if (tris[i].state.isInScreen && CheckCollisionRecs((Rectangle){playerPosition.x - (CELL_SIZE/2 + 30), playerPosition.y - (CELL_SIZE/2 + 30), CELL_SIZE + 60, CELL_SIZE + 60}, 
-            (Rectangle){tris[i].transform.position.x - CELL_SIZE/2, tris[i].transform.position.y - CELL_SIZE/2, CELL_SIZE, CELL_SIZE}))
-            {
-                // Tri is on the player "colision zone"
-                tris[i].collider.isActive = true;
-                
-                // Update collider position
-                UpdateCustomAASATTriPosition(&tris[i].collider.tri, tris[i].transform.position);
-            }
-            else
-            {
-                // Tri is out the player "colision zone"
-                tris[i].collider.isActive = false;
-            }
+            // Custom AA box, bottom points are 1 pixel up
+            platfSpansZone.minX[platfSpansZone.count] = platfSpansColliders[i].points[0].x;
+            platfSpansZone.minY[platfSpansZone.count] = platfSpansColliders[i].points[0].y;
+            platfSpansZone.maxX[platfSpansZone.count] = platfSpansColliders[i].points[2].x;
+            platfSpansZone.maxY[platfSpansZone.count] = platfSpansColliders[i].points[2].y;
+            platfSpansZone.count++;
         }
     }
 }
 
-void CheckPlayerTrisCollision (Player *p, TriGameObject *tris)
+// Sets the chunks bounds (level geometry limits) and creates the ring textures, chunks are baked by UpdateLevelChunks()
+// NOTE: Chunks keep the bottom CHUNK_MAX_HEIGHT pixels (ground side, where the player starts) of higher levels
+void InitLevelChunks ()
 {
-    for (int i=0; i<maxTris; i++)
+    Image atlasImage = LoadAtlasImage("assets/gameplay/sprites.atlas");
+    Image chunkImage;
+    float top = GetScreenHeight() - CELL_SIZE;
+    float bottom = GetScreenHeight();
+    
+    for (int i=0; i<tris.count; i++)
     {
-        if (tris[i].collider.isActive)
+        if (tris.positionY[i] - tris.halfHeight[i] < top) top = tris.positionY[i] - tris.halfHeight[i];
+        if (tris.positionY[i] + tris.halfHeight[i] > bottom) bottom = tris.positionY[i] + tris.halfHeight[i];
+    }
+    
+    for (int i=0; i<platfs.count; i++)
+    {
+        if (platfs.positionY[i] - platfs.halfHeight[i] < top) top = platfs.positionY[i] - platfs.halfHeight[i];
+        if (platfs.positionY[i] + platfs.halfHeight[i] > bottom) bottom = platfs.positionY[i] + platfs.halfHeight[i];
+    }
+    
+    // Level geometry limits are grid rows, so the clamped top is one too
+    isLevelChunksHeightClamped = (bottom - top > CHUNK_MAX_HEIGHT);
+    if (isLevelChunksHeightClamped) top = bottom - CHUNK_MAX_HEIGHT;
+    
+    levelChunksBounds = (Rectangle){0, top, CHUNK_COLUMNS*CELL_SIZE, bottom - top};
+    levelChunksCount = ((int)gridLenght.x + CHUNK_COLUMNS - 1)/CHUNK_COLUMNS;
+    
+    // Remember to free (UnloadLevelChunks)
+    chunkPixels = calloc(levelChunksBounds.width*levelChunksBounds.height, sizeof(Color));
+    trisPixels = LoadChunkSprite(atlasImage, trisRec);
+    platfsPixels = LoadChunkSprite(atlasImage, platfsRec);
+    
+    UnloadImage(atlasImage);
+    
+    chunkImage = LoadImageEx(chunkPixels, levelChunksBounds.width, levelChunksBounds.height);
+    
+    for (int i=0; i<MAX_LEVEL_CHUNKS; i++)
+    {
+        levelChunks[i].texture = LoadTextureFromImage(chunkImage);
+        levelChunks[i].index = -1;
+    }
+    
+    UnloadImage(chunkImage);
+}
+
+void UnloadLevelChunks ()
+{
+    for (int i=0; i<MAX_LEVEL_CHUNKS; i++) UnloadTexture(levelChunks[i].texture);
+    
+    free(chunkPixels);
+    free(trisPixels);
+    free(platfsPixels);
+}
+
+// Copies a sprite (CELL_SIZE x CELL_SIZE) from the atlas pixels, transparent if the atlas could not be loaded
+// NOTE: Atlas images are always UNCOMPRESSED_R8G8B8A8, so pixels are read as Color
+Color *LoadChunkSprite (Image atlasImage, Rectangle rec)
+{
+    Color *sprite = calloc(CELL_SIZE*CELL_SIZE, sizeof(Color)); // Remember to free
+    int width = (rec.width < CELL_SIZE) ? rec.width : CELL_SIZE;
+    int height = (rec.height < CELL_SIZE) ? rec.height : CELL_SIZE;
+    
+    if (atlasImage.data == NULL) return sprite;
+    
+    for (int y=0; y<height; y++)
+    {
+        memcpy(&sprite[y*CELL_SIZE], &((Color *)atlasImage.data)[(rec.y + y)*atlasImage.width + rec.x], sizeof(Color)*width);
+    }
+    
+    return sprite;
+}
+
+// Pre-renders the tris and platfs of a chunk (CPU) and uploads them to the chunk texture
+void BakeLevelChunk (LevelChunk *chunk, int index)
+{
+    memset(chunkPixels, 0, sizeof(Color)*levelChunksBounds.width*levelChunksBounds.height);
+    
+    DrawChunkObjects(&tris, trisPixels, index);
+    DrawChunkObjects(&platfs, platfsPixels, index);
+    
+    UpdateTexture(chunk->texture, chunkPixels);
+    chunk->index = index;
+}
+
+// Copies the sprite of every object on the chunk columns to the bake buffer
+// NOTE: Objects are grid cells (CELL_SIZE, never overlapped), so no blending is needed
+void DrawChunkObjects (GameObjects *objects, Color *sprite, int index)
+{
+    int firstColumn = index*CHUNK_COLUMNS;
+    int lastColumn = firstColumn + CHUNK_COLUMNS;
+    
+    if (lastColumn > gridLenght.x) lastColumn = gridLenght.x;
+    
+    for (int i=objects->columnOffset[firstColumn]; i<objects->columnOffset[lastColumn]; i++)
+    {
+        // Cell top left corner on the chunk
+        int x = objects->positionX[i] - objects->halfWidth[i] - firstColumn*CELL_SIZE;
+        int y = objects->positionY[i] - objects->halfHeight[i] - levelChunksBounds.y;
+        
+        if (y < 0) continue; // Above the chunks (see DrawObjectsAboveChunks)
+        
+        for (int j=0; j<CELL_SIZE; j++)
         {
-            if (SATPolyPolyNCollide(p->collider.box.points, 4, tris[i].collider.tri.points, triNormals, 3))
-            {
-                // Player collided with a triangle
-                // Set player as dead
-                KillPlayer(p);
-            }
+            memcpy(&chunkPixels[(y + j)*levelChunksBounds.width + x], &sprite[j*CELL_SIZE], sizeof(Color)*CELL_SIZE);
+        }
+    }
+}
+
+// Bakes the visible chunks that are not on the ring (only after a camera reset), and the next chunk ahead of the camera, 
+// so a chunk is usually baked a few frames before it enters the screen
+// NOTE: Called once per drawn frame (DrawLevelChunks), not per simulation step: textures are only updated when drawn
+void UpdateLevelChunks ()
+{
+    int firstChunk = firstVisibleColumn/CHUNK_COLUMNS;
+    int lastChunk = (lastVisibleColumn + CHUNK_COLUMNS - 1)/CHUNK_COLUMNS;
+    
+    for (int i=firstChunk; i<lastChunk; i++)
+    {
+        if (levelChunks[i%MAX_LEVEL_CHUNKS].index != i) BakeLevelChunk(&levelChunks[i%MAX_LEVEL_CHUNKS], i);
+    }
+    
+    if (lastChunk < levelChunksCount && levelChunks[lastChunk%MAX_LEVEL_CHUNKS].index != lastChunk)
+    {
+        BakeLevelChunk(&levelChunks[lastChunk%MAX_LEVEL_CHUNKS], lastChunk);
+    }
+}
+
+// Draws the visible chunks, one quad each (baked first if needed)
+void DrawLevelChunks (Vector2 levelCameraOffset)
+{
+    int firstChunk = firstVisibleColumn/CHUNK_COLUMNS;
+    int lastChunk = (lastVisibleColumn + CHUNK_COLUMNS - 1)/CHUNK_COLUMNS;
+    
+    UpdateLevelChunks();
+    
+    for (int i=firstChunk; i<lastChunk; i++)
+    {
+        if (levelChunks[i%MAX_LEVEL_CHUNKS].index == i)
+        {
+            DrawTextureV(levelChunks[i%MAX_LEVEL_CHUNKS].texture, (Vector2){i*levelChunksBounds.width - levelCameraOffset.x, 
+            levelChunksBounds.y - levelCameraOffset.y}, WHITE);
+        }
+    }
+    
+    if (isLevelChunksHeightClamped)
+    {
+        DrawObjectsAboveChunks(&tris, trisRec, levelCameraOffset);
+        DrawObjectsAboveChunks(&platfs, platfsRec, levelCameraOffset);
+    }
+}
+
+// Draws the objects of the visible columns that are above the chunks top and on screen, one sprite each
+void DrawObjectsAboveChunks (GameObjects *objects, Rectangle rec, Vector2 levelCameraOffset)
+{
+    for (int i=objects->columnOffset[firstVisibleColumn]; i<objects->columnOffset[lastVisibleColumn]; i++)
+    {
+        Vector2 onCameraPosition = (Vector2){objects->positionX[i] - levelCameraOffset.x, objects->positionY[i] - levelCameraOffset.y};
+        
+        if (objects->positionY[i] - objects->halfHeight[i] < levelChunksBounds.y && onCameraPosition.y + CELL_SIZE/2 > 0 && 
+            onCameraPosition.y - CELL_SIZE/2 < GetScreenHeight())
+        {
+            DrawTexturePro(atlas.texture, (Rectangle){rec.x, rec.y, CELL_SIZE, CELL_SIZE}, (Rectangle){onCameraPosition.x, 
+            onCameraPosition.y, CELL_SIZE, CELL_SIZE}, (Vector2){CELL_SIZE/2, CELL_SIZE/2}, 0, WHITE);
         }
     }
 }
 
-void UpdatePlatfs (BoxGameObject *platfs, Vector2 *sourcePosition, Vector2 playerPosition, Camera2D camera)
+// Time of impact [0, 1] of a box (min/max limits) moving by displacement against a static box (-1 if they don't collide).
+// NOTE: Slabs method, checked axis by axis
+float GetSweptBoxesImpactTime (float *boxMin, float *boxMax, Vector2 displacement, float *staticMin, float *staticMax)
 {
-    for (int i=0; i<maxPlatfs; i++)
+    float axisDisplacement[2] = { displacement.x, displacement.y };
+    float enterTime = 0;
+    float exitTime = 1;
+    
+    for (int i=0; i<2; i++)
     {
-        if (platfs[i].state.isActive)
+        if (axisDisplacement[i] == 0)
         {
-            UpdateOnCameraGameObject(&platfs[i].transform.position, &platfs[i].state, sourcePosition[i], camera, mainCamera);
+            // Not moving on this axis, limits must already overlap
+            if (boxMax[i] < staticMin[i] || staticMax[i] < boxMin[i]) return -1;
+        }
+        else
+        {
+            float t1 = (staticMin[i] - boxMax[i])/axisDisplacement[i];
+            float t2 = (staticMax[i] - boxMin[i])/axisDisplacement[i];
             
-            if (platfs[i].state.isInScreen && CheckCollisionRecs((Rectangle){playerPosition.x - (CELL_SIZE/2 + 30), playerPosition.y - (CELL_SIZE/2 + 30), CELL_SIZE + 60, CELL_SIZE + 60}, 
-            (Rectangle){platfs[i].transform.position.x - CELL_SIZE/2, platfs[i].transform.position.y - CELL_SIZE/2, CELL_SIZE, CELL_SIZE}))
-            {
-                // Platf is on the player "colision zone"
-                platfs[i].collider.isActive = true;
-                
-                // Update collider position
-                UpdateCustomAASATBoxPosition(&platfs[i].collider.box, platfs[i].transform.position);
-            }
-            else platfs[i].collider.isActive = false;
+            if (t1 > t2) FloatSwap(&t1, &t2);
+            if (t1 > enterTime) enterTime = t1;
+            if (t2 < exitTime) exitTime = t2;
+            
+            if (enterTime > exitTime) return -1;
         }
     }
+    
+    return enterTime;
 }
 
-void CheckPlayerPlatfsCollision (Player *p, BoxGameObject *platfs)
+// Player collided with a platform span: lands on it if it was above it on the previous frame, dies otherwise
+void SetPlayerPlatfCollision (Player *p, int zoneIndex)
 {
-    for (int i=0; i<maxPlatfs; i++)
+    // Span top back to the player space
+    float spanTop = platfSpansZone.minY[zoneIndex] - gameElementsCamera.position.y;
+    
+    if (p->dynamic.prevPosition.y + CELL_SIZE/2 <= spanTop)
+    {
+        // Player landed on a platform
+        SetPlayerAsGrounded(p, spanTop);
+        // Set player previous position
+        p->dynamic.prevPosition = p->transform.position;
+    }
+    else
+    {
+        // Set player as dead
+        KillPlayer(p);
+    }
+}
+
+void CheckPlayerPlatfsCollision (Player *p)
+{
+    Vector2 playerPoints[4];
+    Vector2 displacement = GetPlayerLevelDisplacement(p);
+    
+    GetPlayerLevelPoints(p, playerPoints);
+    UpdatePlatfSpansZone(GetPlayerCollisionZone(p, displacement));
+    
+    if (SATPolyAABoxesBatchCollide(playerPoints, 4, platfSpansZone, platfSpansZoneResults) > 0)
+    {
+        for (int i=0; i<platfSpansZone.count; i++)
+        {
+            if (platfSpansZoneResults[i]) SetPlayerPlatfCollision(p, i);
+        }
+    }
+    else if (fabsf(displacement.x) > SWEEP_STEP || fabsf(displacement.y) > SWEEP_STEP)
     {
-        if (platfs[i].collider.isActive)
+        // Fast movement: sweep the player bounds from the previous position, so it can't pass through a platform
+        float boxMin[2] = { playerPoints[0].x, playerPoints[0].y };
+        float boxMax[2] = { playerPoints[0].x, playerPoints[0].y };
+        float impactTime = 2;
+        int impactIndex = -1;
+        
+        for (int i=1; i<4; i++)
+        {
+            boxMin[0] = fminf(boxMin[0], playerPoints[i].x);
+            boxMin[1] = fminf(boxMin[1], playerPoints[i].y);
+            boxMax[0] = fmaxf(boxMax[0], playerPoints[i].x);
+            boxMax[1] = fmaxf(boxMax[1], playerPoints[i].y);
+        }
+        
+        // Back to the previous position
+        boxMin[0] -= displacement.x;
+        boxMin[1] -= displacement.y;
+        boxMax[0] -= displacement.x;
+        boxMax[1] -= displacement.y;
+        
+        for (int i=0; i<platfSpansZone.count; i++)
         {
-            if (SATPolyPolyNCollide(p->collider.box.points, 4, platfs[i].collider.box.points, triNormals, 4))
+            float staticMin[2] = { platfSpansZone.minX[i], platfSpansZone.minY[i] };
+            float staticMax[2] = { platfSpansZone.maxX[i], platfSpansZone.maxY[i] };
+            float time = GetSweptBoxesImpactTime(boxMin, boxMax, displacement, staticMin, staticMax);
+            
+            if (time >= 0 && time < impactTime)
             {
-                // Player collided with a platform
-                
-                if (p->dynamic.prevPosition.y + CELL_SIZE/2 <= platfs[i].transform.position.y - CELL_SIZE/2)
-                {
-                    // Player landed on a platform
-                    SetPlayerAsGrounded(p, platfs[i].transform.position.y - CELL_SIZE/2);
-                    // Set player previous position
-                    p->dynamic.prevPosition = p->transform.position;
-                }
-                else
-                {
-                    // Set player as dead
-                    KillPlayer(p);
-                }
+                impactTime = time;
+                impactIndex = i;
             }
         }
+        
+        if (impactIndex >= 0) SetPlayerPlatfCollision(p, impactIndex);
     }
 }
 
@@ -1166,22 +1669,12 @@ void ResetGameplay ()
             
             player.pEmitter.isBurst = false;
             
-            for (int i=0; i<PLAYER_PARTICLES; i++)
-            {
-                player.pEmitter.particles[i].isActive = false;
-            }
+            ResetParticles(&player.pEmitter.particles);
             
             player.onDeadPEmitter.isActive = false;
             
-            for (int i=0; i<PLAYER_ONDEAD_PARTICLES; i++)
-            {
-                player.onDeadPEmitter.particles[i].isActive = false;
-            }
-            
-            for (int i=0; i<FG_PARTICLES; i++)
-            {
-                fgPEmitter.particles[i].isActive = false;
-            }
+            ResetParticles(&player.onDeadPEmitter.particles);
+            ResetParticles(&fgPEmitter.particles);
             
             player.onDeadScaleEasing.t = 0;
             player.onDeadCircleSize = 0;
@@ -1190,25 +1683,21 @@ void ResetGameplay ()
             attemptsCounterPosition = attemptsCounterSourcePosition;
             attemptsCounter++;
             
+            SetAttemptParticlesSeeds();
+            
             UpdateSATBox(&player.collider.box, player.transform.position, Vector2FloatProduct(player.collider.box.size, player.transform.scale), player.transform.rotation);
             
             player.isAlive = true;
             
-            for (int i=0; i<maxTris; i++)
-            {
-                tris[i].state.isActive = true;
-                tris[i].state.isInScreen = false;
-                tris[i].collider.isActive = false;
-            }
-            UpdateTris(tris, trisSourcePosition, player.transform.position, gameElementsCamera);
+            SetPrevStepState(); // Reset positions are not interpolated
             
-            for (int i=0; i<maxPlatfs; i++)
-            {
-                platfs[i].state.isActive = true;
-                platfs[i].state.isInScreen = false;
-                platfs[i].collider.isActive = false;
-            }
-            UpdatePlatfs (platfs, platfsSourcePosition, player.transform.position, gameElementsCamera); 
+            UpdateVisibleColumns(gameElementsCamera);
+            
+            ResetGameObjects(&tris);
+            ResetGameObjects(&platfSpans);
+            
+            UpdateTris(gameElementsCamera);
+            UpdatePlatfSpans(gameElementsCamera);
             
             progressBar.front.width = 0;
             progressBar.isActive = true;
@@ -1232,226 +1721,188 @@ void ResetGameplay ()
 
 void InitTri(int index, Vector2 coordinates, int yGridLenght)
 {
-        tris[index].transform.position = GetOnGridPosition(coordinates);
-        tris[index].transform.position.y -= yGridLenght * CELL_SIZE - GetScreenHeight();
-        tris[index].transform.scale = 1;
-        tris[index].transform.rotation = 0;
-        trisSourcePosition[index] = tris[index].transform.position;
-        
-        InitSATTri(&tris[index].collider.tri, tris[index].transform.position, (Vector2){CELL_SIZE, CELL_SIZE}, tris[index].transform.rotation);
-        tris[index].collider.isActive = false;
+    Vector2 position = GetOnGridPosition(coordinates);
+    position.y -= yGridLenght * CELL_SIZE - GetScreenHeight();
     
-        tris[index].state.isActive = true;
-        tris[index].state.isInScreen = false;
-        tris[index].state.isUp = true;
+    SetGameObject(&tris, index, position, (Vector2){CELL_SIZE, CELL_SIZE});
+    
+    trisColliders[index].size = (Vector2){CELL_SIZE, CELL_SIZE};
+    UpdateCustomAASATTriPosition(&trisColliders[index], position);
 }
 
 void InitPlatf(int index, Vector2 coordinates, int yGridLenght)
 {
-    platfs[index].transform.position = GetOnGridPosition(coordinates);
-    platfs[index].transform.position.y -= yGridLenght * CELL_SIZE - GetScreenHeight();
-    platfs[index].transform.scale = 1;
-    platfs[index].transform.rotation = 0;
-    platfsSourcePosition[index] = platfs[index].transform.position;
-
-    InitSATBox(&platfs[index].collider.box, platfs[index].transform.position, (Vector2){CELL_SIZE, CELL_SIZE}, platfs[index].transform.rotation);
-    platfs[index].collider.isActive = false;
-
-    platfs[index].state.isActive = true;
-    platfs[index].state.isInScreen = false;
-    platfs[index].state.isUp = true;
+    Vector2 position = GetOnGridPosition(coordinates);
+    position.y -= yGridLenght * CELL_SIZE - GetScreenHeight();
+    
+    SetGameObject(&platfs, index, position, (Vector2){CELL_SIZE, CELL_SIZE});
 }
 
-void LoadMap ()
+// Greedy merge of the platform cells into rectangular span colliders: every span grows to the right first
+// (up to PLATF_SPAN_MAX_CELLS) and then down, as long as all the cells below are also platforms.
+// NOTE: Only a window of PLATF_SPAN_MAX_CELLS columns is kept in memory (ring buffer), not the whole grid,
+// so the pass is O(platform cells).
+void InitPlatfSpans ()
 {
-    Image mapImage;
-    Color *mapImagePixels;
-    
-    int trisCounter = 0;
-    int platfsCounter = 0;
+    unsigned char cells[PLATF_SPAN_MAX_CELLS][LEVEL_MAX_HEIGHT]; // 0: empty, 1: platform, 2: already merged
+    int loadedColumns = 0;
+    int spansCounter = 0;
+    int width = gridLenght.x;
+    int height = gridLenght.y;
     
-    maxTris = 0;
-    maxPlatfs = 0;
+    memset(cells, 0, sizeof(cells));
     
-    mapImage = LoadImage("maps/map_02.bmp");
-    gridLenght.x = mapImage.width;
-    gridLenght.y = mapImage.height;
-    mapImagePixels = malloc(sizeof(Color)*(gridLenght.x*gridLenght.y));
+    InitGameObjects(&platfSpans, platfs.count); // Worst case, one span per cell
+    platfSpansColliders = malloc(sizeof(SATBox) * platfs.count);
+    platfSpansColumnOffset = malloc(sizeof(unsigned int) * (width + 1));
+    platfSpans.columnOffset = platfSpansColumnOffset;
     
-    mapImagePixels = GetImageData(mapImage);
-    
-    for (int i=0; i<gridLenght.x*gridLenght.y; i++)
+    for (int x=0; x<width; x++)
     {
-        if (SameColor(mapImagePixels[i], (Color){255, 0, 0, 255})) maxTris++;
-        else if (SameColor(mapImagePixels[i], (Color){0, 255, 0, 255})) maxPlatfs++;
-    }
-    
-    tris = malloc(sizeof(TriGameObject) * maxTris);
-    trisSourcePosition = malloc(sizeof(TriGameObject) * maxTris);
-    platfs = malloc(sizeof(BoxGameObject) * maxPlatfs);
-    platfsSourcePosition = malloc(sizeof(BoxGameObject) * maxPlatfs);
-    
-    for (int y=0; y<gridLenght.y; y++)
-    {
-        for (int x=0; x<gridLenght.x; x++)
+        // Load the columns that can be merged with this one
+        while (loadedColumns < x + PLATF_SPAN_MAX_CELLS && loadedColumns < width)
         {
-            if (SameColor(mapImagePixels[y*(int)gridLenght.x+x], (Color){255, 0, 0, 255}))
+            unsigned char *column = cells[loadedColumns % PLATF_SPAN_MAX_CELLS];
+            
+            // Clear the column previously stored on this slot
+            if (loadedColumns >= PLATF_SPAN_MAX_CELLS)
             {
-                // Init tri
-                InitTri(trisCounter, (Vector2){x, y}, gridLenght.y-1);
-                trisCounter++;
+                int oldColumn = loadedColumns - PLATF_SPAN_MAX_CELLS;
+                for (int i=platfs.columnOffset[oldColumn]; i<platfs.columnOffset[oldColumn + 1]; i++) column[level.platfs[i].y] = 0;
             }
-            else if (SameColor(mapImagePixels[y*(int)gridLenght.x+x], (Color){0, 255, 0, 255}))
+            
+            for (int i=platfs.columnOffset[loadedColumns]; i<platfs.columnOffset[loadedColumns + 1]; i++) column[level.platfs[i].y] = 1;
+            
+            loadedColumns++;
+        }
+        
+        platfSpansColumnOffset[x] = spansCounter;
+        
+        for (int y=0; y<height; y++)
+        {
+            if (cells[x % PLATF_SPAN_MAX_CELLS][y] == 1)
             {
-                // Init platf
-                InitPlatf(platfsCounter, (Vector2){x, y}, gridLenght.y-1);
-                platfsCounter++;
+                Vector2 spanPosition;
+                int spanWidth = 1;
+                int spanHeight = 1;
+                bool isRowFull = true;
+                
+                while (x + spanWidth < width && spanWidth < PLATF_SPAN_MAX_CELLS && cells[(x + spanWidth) % PLATF_SPAN_MAX_CELLS][y] == 1) spanWidth++;
+                
+                while (isRowFull && y + spanHeight < height)
+                {
+                    for (int i=0; i<spanWidth; i++)
+                    {
+                        if (cells[(x + i) % PLATF_SPAN_MAX_CELLS][y + spanHeight] != 1) isRowFull = false;
+                    }
+                    
+                    if (isRowFull) spanHeight++;
+                }
+                
+                for (int i=0; i<spanWidth; i++)
+                {
+                    for (int j=0; j<spanHeight; j++) cells[(x + i) % PLATF_SPAN_MAX_CELLS][y + j] = 2;
+                }
+                
+                // Span center (same vertical placement than InitPlatf)
+                spanPosition = GetOnGridPosition((Vector2){x, y});
+                spanPosition.x += (spanWidth - 1) * CELL_SIZE/2.0f;
+                spanPosition.y += (spanHeight - 1) * CELL_SIZE/2.0f - ((height - 1) * CELL_SIZE - GetScreenHeight());
+                
+                SetGameObject(&platfSpans, spansCounter, spanPosition, (Vector2){spanWidth * CELL_SIZE, spanHeight * CELL_SIZE});
+                
+                platfSpansColliders[spansCounter].size = (Vector2){spanWidth * CELL_SIZE, spanHeight * CELL_SIZE};
+                UpdateCustomAASATBoxPosition(&platfSpansColliders[spansCounter], spanPosition);
+                
+                spansCounter++;
             }
         }
     }
     
-    free(mapImagePixels);
-    UnloadImage(mapImage);
-}
-
-bool SameColor(Color a, Color b)
-{
-    if (a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a)
-    {
-        return true;
-    }
-    return false;
+    platfSpansColumnOffset[width] = spansCounter;
+    platfSpans.count = spansCounter;
 }
 
-void UpdateCustomAASATTriPosition (SATTri *tri, Vector2 position)
+void LoadMap ()
 {
-    if (tri->position.x != position.x || tri->position.y != position.y)
+    // Use the compiled level (see levelc), it is mapped and used in place
+    int isLoaded = LoadLevel(&level, (levelFileName != NULL) ? levelFileName : "maps/map_02.lvl");
+    
+    if (!isLoaded && levelFileName == NULL)
     {
-        Vector2 size;
-        
-        tri->position = position;
-        size = tri->size;
+        // Authoring fallback: compile the map bitmap in memory
+        Image mapImage = LoadImage("maps/map_02.bmp");
+        Color *mapImagePixels = GetImageData(mapImage);
         
-        // Set half-size for faster use on points asignation
-        Vector2Scale(&size, 0.5f);
+        isLoaded = (mapImagePixels != NULL) && LoadLevelFromPixels(&level, (unsigned char *)mapImagePixels, mapImage.width, mapImage.height);
         
-        // Set tri corners position
-        tri->points[0] = Vector2Add(tri->position, Vector2Product((Vector2){-1, 1}, size));
-        tri->points[1] = Vector2Add(tri->position, Vector2Product((Vector2){0, -1}, size));
-        tri->points[2] = Vector2Add(tri->position, Vector2Product((Vector2){1, 1}, size));
-        
-        // Set top point 1 pixel down
-        tri->points[1].y+= 1;
+        free(mapImagePixels);
+        UnloadImage(mapImage);
     }
-}
-
-void UpdateCustomAASATBoxPosition (SATBox *box, Vector2 position)
-{
-    if (box->position.x != position.x || box->position.y != position.y)
+    
+    if (!isLoaded)
     {
-        Vector2 size;
-        
-        box->position = position;
-        size = box->size;
+        // No level or map bitmap: play an empty level, so the game still runs (and shows the level is missing)
+        unsigned char *emptyPixels = calloc(EMPTY_LEVEL_WIDTH * EMPTY_LEVEL_HEIGHT, 4);
         
-        Vector2Scale(&size, 0.5f);
-        
-        box->points[0] = Vector2Sub(box->position, Vector2Product(Vector2One(), size));
-        box->points[1] = Vector2Add(box->position, Vector2Product((Vector2){1, -1}, size));
-        box->points[2] = Vector2Add(box->position, Vector2Product(Vector2One(), size));
-        box->points[3] = Vector2Sub(box->position, Vector2Product((Vector2){1, -1}, size));
-        
-        // Set box bot points 1 pexel up 
-        box->points[2].y-=1;
-        box->points[3].y-=1;
+        fprintf(stderr, "%s: error: could not load the level file or the map bitmap, using an empty level\n", (levelFileName != NULL) ? levelFileName : "maps/map_02");
+        LoadLevelFromPixels(&level, emptyPixels, EMPTY_LEVEL_WIDTH, EMPTY_LEVEL_HEIGHT);
+        free(emptyPixels);
     }
+    
+    gridLenght.x = level.header->width;
+    gridLenght.y = level.header->height;
+    
+    InitGameObjects(&tris, level.header->trisCount);
+    trisColliders = malloc(sizeof(SATTri) * tris.count);
+    InitGameObjects(&platfs, level.header->platfsCount);
+    
+    // Level cells are already sorted by grid column, so the column index is used as it is
+    tris.columnOffset = level.trisColumnOffset;
+    platfs.columnOffset = level.platfsColumnOffset;
+    
+    for (int i=0; i<tris.count; i++) InitTri(i, (Vector2){level.tris[i].x, level.tris[i].y}, gridLenght.y-1);
+    for (int i=0; i<platfs.count; i++) InitPlatf(i, (Vector2){level.platfs[i].x, level.platfs[i].y}, gridLenght.y-1);
+    
+    InitPlatfSpans();
 }
 
-float GetRandomFloat(float min, float max)
-{
-    return (max-min) * ((float)rand() / (float) RAND_MAX) + min;
-}
-
-Vector2 GetRandomVector2(Vector2 v1, Vector2 v2)
-{
-    return (Vector2){GetRandomFloat(v1.x, v2.x), GetRandomFloat(v1.y, v2.y)};
-}
-
-void UpdateParticleEmitter (ParticleEmitter *pE, int maxParticles, Vector2 position)
+void UpdateCustomAASATTriPosition (SATTri *tri, Vector2 position)
 {
-    if (pE->isActive)
-    {
-        pE->position = Vector2Add(position, pE->offset);
-        
-        if (!pE->isBurst)
-        {
-            pE->frameParticles = pE->ppf + pE->remainingParticles;
-            pE->particlesAmount = pE->frameParticles/1;
-            pE->remainingParticles = fmod(pE->frameParticles, 1);
-            
-            for (int i=0; i<maxParticles; i++)
-            {
-                if (!pE->particles[i].isActive)
-                {
-                    // Init particle
-                    if (pE->particlesAmount > 0)
-                    {
-                    InitParticle(&pE->particles[i], pE->source, pE->spawnRadius, pE->position);
-                    pE->particlesAmount--;
-                    }
-                    else i=maxParticles;
-                }
-            }
-        }
-        for (int i=0; i<maxParticles; i++)
-        {
-            UpdateParticle(&pE->particles[i], pE->gravity);
-            //if (pE->particles[i].isActive) printf("P: %i \n", i);
-        }
-    }
-}
-
-void InitParticle (Particle *p, SourceParticle s, float spawnRadius, Vector2 pEPosition)
-{   
-    if (spawnRadius!= 0)
-    {
-        p->transform.position = Vector2Add(pEPosition, (Vector2){0, GetRandomFloat(0, -spawnRadius)});
-        Vector2Rotate(&p->transform.position, pEPosition, GetRandomValue(0, 360));
-    }   
-    else p->transform.position = pEPosition;
+    Vector2 size;
     
-    p->transform.rotation = GetRandomFloat(s.rotation[0], s.rotation[1]);
-    p->transform.scale = GetRandomFloat(s.scale[0], s.scale[1]);
+    tri->position = position;
+    size = tri->size;
     
-    p->direction = GetRandomVector2(s.direction[0], s.direction[1]);
-    p->movementSpeed = GetRandomVector2(s.movementSpeed[0], s.movementSpeed[1]);
-    p->velocity = Vector2Product(p->movementSpeed, p->direction);
-    p->rotationSpeed = GetRandomFloat(s.rotationSpeed[0], s.rotationSpeed[1]);
-    p->scaleSpeed = GetRandomFloat(s.scaleSpeed[0], s.scaleSpeed[1]);
-    p->lifeTime = GetRandomValue(s.lifeTime[0], s.lifeTime[1]);
+    // Set half-size for faster use on points asignation
+    Vector2Scale(&size, 0.5f);
     
-    p->color = s.color;
+    // Set tri corners position
+    tri->points[0] = Vector2Add(tri->position, Vector2Product((Vector2){-1, 1}, size));
+    tri->points[1] = Vector2Add(tri->position, Vector2Product((Vector2){0, -1}, size));
+    tri->points[2] = Vector2Add(tri->position, Vector2Product((Vector2){1, 1}, size));
     
-    p->isActive = true;
+    // Set top point 1 pixel down
+    tri->points[1].y+= 1;
 }
 
-void UpdateParticle(Particle *p, GravityForce gravity)
+void UpdateCustomAASATBoxPosition (SATBox *box, Vector2 position)
 {
-    if (p->isActive)
-    {
-        if (p->lifeTime > 0)
-        {
-            p->velocity = Vector2Add(p->velocity, gravity.force);
-            p->transform.position = Vector2Add(p->transform.position, p->velocity);
-            p->transform.rotation += p->rotationSpeed;
-            p->transform.scale += p->scaleSpeed;
-            
-            p->lifeTime--;
-            
-            if (p->lifeTime <= 0) p->isActive = false;
-        }
-        else p->isActive = false;
-    }
+    Vector2 size;
+    
+    box->position = position;
+    size = box->size;
+    
+    Vector2Scale(&size, 0.5f);
+    
+    box->points[0] = Vector2Sub(box->position, Vector2Product(Vector2One(), size));
+    box->points[1] = Vector2Add(box->position, Vector2Product((Vector2){1, -1}, size));
+    box->points[2] = Vector2Add(box->position, Vector2Product(Vector2One(), size));
+    box->points[3] = Vector2Sub(box->position, Vector2Product((Vector2){1, -1}, size));
+    
+    // Set box bot points 1 pexel up 
+    box->points[2].y-=1;
+    box->points[3].y-=1;
 }
 
 void KillPlayer (Player *p)
@@ -1468,11 +1919,8 @@ void KillPlayer (Player *p)
     // Init onDeadPEmitter
     p->onDeadPEmitter.position = p->transform.position;
     
-    for (int i=0; i<PLAYER_ONDEAD_PARTICLES; i++)
-    {
-        // Init particle
-        InitParticle(&p->onDeadPEmitter.particles[i], p->onDeadPEmitter.source, p->onDeadPEmitter.spawnRadius, p->onDeadPEmitter.position);
-    }
+    ResetParticles(&p->onDeadPEmitter.particles);
+    SpawnParticles(&p->onDeadPEmitter.particles, p->onDeadPEmitter.source, p->onDeadPEmitter.spawnRadius, p->onDeadPEmitter.position, PLAYER_ONDEAD_PARTICLES);
     
     StopMusicStream();
 }
@@ -1483,4 +1931,57 @@ float CosInterpolation (float start, float end, float percent)
     
     percent = (-cos(PI * percent)) / 2 + .5f;
     return start + percent * (end - start);
-}
\ No newline at end of file
+}
+
+void InitTiledLayer (TiledLayer *layer, const char *fileName, Vector2 position, float scale, float parallax)
+{
+    layer->texture = LoadTexture(fileName);
+    layer->position = position;
+    layer->scale = scale;
+    layer->parallax = parallax;
+}
+
+// Draws the layer over the whole screen width as a single quad: the source rectangle is wider than the texture,
+// so its texture coordinates go over 1 and the texture repeats. Horizontal scroll is the texture offset.
+// NOTE: Texture offset is wrapped to the texture width, so it is always small (exact as a texture coordinate)
+void DrawTiledLayer (TiledLayer layer, Vector2 cameraPosition)
+{
+    float offset = fmodf(cameraPosition.x*layer.parallax/layer.scale, layer.texture.width);
+    int width = ceilf(GetScreenWidth()/layer.scale);
+    
+    DrawTexturePro(layer.texture, (Rectangle){offset, 0, width, layer.texture.height}, (Rectangle){layer.position.x, 
+    layer.position.y - cameraPosition.y*layer.parallax, width*layer.scale, layer.texture.height*layer.scale}, Vector2Zero(), 0, WHITE);
+}
+
+// Keeps the state drawn interpolated (player and cameras) before running a simulation step
+void SetPrevStepState ()
+{
+    gameElementsCamera.prevPosition = gameElementsCamera.position;
+    mainCamera.prevPosition = mainCamera.position;
+    player.prevTransform = player.transform;
+}
+
+Vector2 GetInterpolatedPosition (Vector2 prevPosition, Vector2 position)
+{
+    float alpha = GetRenderAlpha();
+    
+    return (Vector2){prevPosition.x + (position.x - prevPosition.x)*alpha, prevPosition.y + (position.y - prevPosition.y)*alpha};
+}
+
+// Interpolates on the shortest direction (rotation wraps at 360)
+float GetInterpolatedRotation (float prevRotation, float rotation)
+{
+    float delta = fmodf(rotation - prevRotation + 540, 360) - 180;
+    
+    return prevRotation + delta*GetRenderAlpha();
+}
+
+// Every attempt gets its own particles random streams (from the session seed), so it only depends on its own input
+void SetAttemptParticlesSeeds ()
+{
+    unsigned int seed = particlesSeed + (attemptsCounter - 1)*3;
+    
+    SetParticlesSeed(&player.pEmitter.particles, seed);
+    SetParticlesSeed(&player.onDeadPEmitter.particles, seed + 1);
+    SetParticlesSeed(&fgPEmitter.particles, seed + 2);
+}
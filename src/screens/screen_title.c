@@ -25,6 +25,8 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "textcache.h"
+#include "input.h"
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition (local to this module)
@@ -85,10 +87,10 @@ void UpdateTitleScreen(void)
 {
     // Update TITLE screen
     
-    if (IsKeyPressed('C')) showCredits = !showCredits;
+    if (IsGameKeyPressed('C')) showCredits = !showCredits;
 
     // Press SPACE to change to GAMEPLAY screen
-    if (IsKeyPressed(KEY_SPACE))
+    if (IsGameKeyPressed(KEY_SPACE))
     {
         //finishScreen = 1;   // OPTIONS
         finishScreen = 2;   // GAMEPLAY
@@ -129,11 +131,11 @@ void DrawTitleScreen(void)
     DrawTextureEx(titleTexture, (Vector2){GetScreenWidth()/2-(titleTexture.width*titleTextureScale)/2, GetScreenHeight()/2-(titleTexture.height*titleTextureScale)/2-50}, 
     0, titleTextureScale, WHITE);
     
-    DrawText(playMessage, GetScreenWidth()/2-MeasureText(playMessage, playMessageFontSize)/2, GetScreenHeight()-100, playMessageFontSize, Fade(YELLOW, playMessageAlpha));
+    DrawCachedText(playMessage, GetScreenWidth()/2-MeasureText(playMessage, playMessageFontSize)/2, GetScreenHeight()-100, playMessageFontSize, Fade(YELLOW, playMessageAlpha));
     
-    DrawText("Press <P> in game for volume settings", 10, GetScreenHeight() - 22, 20, WHITE);
+    DrawCachedText("Press <P> in game for volume settings", 10, GetScreenHeight() - 22, 20, WHITE);
     
-    DrawText("Copyright (c) 2016 Marc Montagut", GetScreenWidth()/2 + 105, GetScreenHeight() / 2 + 5, 20, WHITE);
+    DrawCachedText("Copyright (c) 2016 Marc Montagut", GetScreenWidth()/2 + 105, GetScreenHeight() / 2 + 5, 20, WHITE);
 }
 
 // Title Screen Unload logic
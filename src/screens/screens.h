@@ -40,6 +40,11 @@ GameScreen currentScreen;
 extern "C" {            // Prevents name mangling of functions
 #endif
 
+//----------------------------------------------------------------------------------
+// Frame Timing Functions Declaration
+//----------------------------------------------------------------------------------
+float GetRenderAlpha(void);     // Drawn frame time between the last two simulation steps [0, 1] (to interpolate them)
+
 //----------------------------------------------------------------------------------
 // Loading Screen Functions Declaration
 //----------------------------------------------------------------------------------
@@ -84,6 +89,14 @@ void UpdateGameplayScreen(void);
 void DrawGameplayScreen(void);
 void UnloadGameplayScreen(void);
 int FinishGameplayScreen(void);
+int IsGameplayPlayerAlive(void);   // Simulation state (headless runs)
+int GetGameplayAttempts(void);     // Current attempt (starts at 1, increased on every reset after dying)
+void SetGameplaySeed(unsigned int seed);           // Random seed of the next session (replays), 0 for a new one
+void SetGameplayReplayFile(const char *fileName);  // Session input is saved on unload (NULL: not saved)
+void SetGameplayLevelFile(const char *fileName);   // Compiled level played instead of the game one (NULL: the game one)
+unsigned long long GetGameplayLevelHash(void);
+unsigned int GetGameplaySeed(void);
+unsigned long long GetGameplayStateHash(void);     // 64-bit hash of the simulation state (desyncs detection, see statehash.h)
 
 //----------------------------------------------------------------------------------
 // Ending Screen Functions Declaration
@@ -0,0 +1,109 @@
+/*
+*   statehash.c
+*
+*   Tap To JAmp simulation state hashes. Made by Marc Montagut - @MarcMDE
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#include "statehash.h"
+#include <string.h>
+
+#define STATE_HASH_PRIME 0x100000001b3ULL // FNV-1a 64 prime
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+// FNV-1a on 8 bytes words (instead of single bytes), high bits are folded back after every
+// multiply so a change on any byte reaches the whole hash
+unsigned long long HashStateData (unsigned long long hash, const void *data, int size)
+{
+    const unsigned char *bytes = data;
+    unsigned long long word;
+
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        memcpy(&word, bytes, 8);
+
+        hash = (hash ^ word)*STATE_HASH_PRIME;
+        hash ^= hash >> 29;
+    }
+
+    if (size > 0)
+    {
+        word = 0;
+        memcpy(&word, bytes, size);
+
+        hash = (hash ^ word ^ ((unsigned long long)size << 56))*STATE_HASH_PRIME;
+        hash ^= hash >> 29;
+    }
+
+    return hash;
+}
+
+FILE *OpenStateHashStream (const char *fileName, unsigned long long levelHash, unsigned int seed)
+{
+    StateHashHeader header = { STATE_HASH_FILE_MAGIC, STATE_HASH_FILE_VERSION, levelHash, seed, 0 };
+    FILE *stream = fopen(fileName, "wb");
+
+    if (stream != NULL && fwrite(&header, sizeof(StateHashHeader), 1, stream) != 1)
+    {
+        fclose(stream);
+        remove(fileName);
+        stream = NULL;
+    }
+
+    return stream;
+}
+
+// NOTE: Writes are buffered by stdio, a step only copies 8 bytes
+void WriteStateHash (FILE *stream, unsigned long long hash)
+{
+    fwrite(&hash, sizeof(hash), 1, stream);
+}
+
+int CloseStateHashStream (FILE *stream)
+{
+    int isWritten = !ferror(stream);
+
+    if (fclose(stream) != 0) isWritten = 0;
+
+    return isWritten;
+}
+
+FILE *LoadStateHashStream (const char *fileName, StateHashHeader *header)
+{
+    FILE *stream = fopen(fileName, "rb");
+
+    if (stream == NULL) return NULL;
+
+    if (fread(header, sizeof(StateHashHeader), 1, stream) != 1 || header->magic != STATE_HASH_FILE_MAGIC || header->version != STATE_HASH_FILE_VERSION)
+    {
+        fclose(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+int ReadStateHash (FILE *stream, unsigned long long *hash)
+{
+    return (fread(hash, sizeof(unsigned long long), 1, stream) == 1);
+}
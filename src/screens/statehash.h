@@ -0,0 +1,75 @@
+/*
+*   statehash.h
+*
+*   Tap To JAmp simulation state hashes. Made by Marc Montagut - @MarcMDE
+*
+*   A 64-bit hash of the gameplay state is computed after every simulation step and written to a
+*   stream file, so two runs (replays, headless runs, builds of other compilers) can be compared
+*   step by step with hashcmp, which reports the first step where they diverge.
+*   Layout (little endian, 4 bytes aligned):
+*
+*       StateHashHeader     header
+*       unsigned long long  hashes[] (one per simulation step, until the end of the file)
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <stdio.h>
+
+// NOTE: This module does not include raylib.h, so it can be used by the offline tools (hashcmp)
+
+#define STATE_HASH_FILE_MAGIC 0x48534a54 // "TJSH"
+#define STATE_HASH_FILE_VERSION 2
+
+#define STATE_HASH_BASIS 0xcbf29ce484222325ULL // Initial hash value
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Structs
+// ---------------------------
+typedef struct StateHashHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned long long levelHash; // GetLevelHash() of the simulated level
+    unsigned int seed; // Gameplay random seed
+    unsigned int reserved;
+}StateHashHeader;
+// ----------------------------
+
+// Functions
+// ----------------------------
+unsigned long long HashStateData (unsigned long long hash, const void *data, int size); // Adds data to the hash (8 bytes per step)
+FILE *OpenStateHashStream (const char *fileName, unsigned long long levelHash, unsigned int seed); // Writes the header, returns NULL on failure
+void WriteStateHash (FILE *stream, unsigned long long hash);
+int CloseStateHashStream (FILE *stream); // Returns 0 if any write failed
+FILE *LoadStateHashStream (const char *fileName, StateHashHeader *header); // Reads the header, returns NULL on failure
+int ReadStateHash (FILE *stream, unsigned long long *hash); // Returns 0 at the end of the stream
+// ----------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STATEHASH_H
@@ -0,0 +1,110 @@
+/*
+*   textcache.c
+*
+*   Tap To JAmp text cache. Made by Marc Montagut - @MarcMDE
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#include "textcache.h"
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct CachedText
+{
+    char text[TEXT_CACHE_LENGHT];
+    int fontSize;
+    Texture2D texture; // Text in white (id 0 if the entry is free)
+    unsigned int lastUse; // Draw call counter on the last draw
+}CachedText;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition (local to this module)
+//----------------------------------------------------------------------------------
+static CachedText cache[TEXT_CACHE_SIZE];
+static unsigned int drawsCounter;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//----------------------------------------------------------------------------------
+static CachedText *GetCachedText (const char *text, int fontSize);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+void DrawCachedText (const char *text, int posX, int posY, int fontSize, Color color)
+{
+    CachedText *cachedText;
+
+    if (text[0] == '\0') return;
+
+    if (strlen(text) >= TEXT_CACHE_LENGHT)
+    {
+        DrawText(text, posX, posY, fontSize, color);
+        return;
+    }
+
+    cachedText = GetCachedText(text, fontSize);
+    cachedText->lastUse = ++drawsCounter;
+
+    DrawTexture(cachedText->texture, posX, posY, color);
+}
+
+void UnloadTextCache (void)
+{
+    for (int i=0; i<TEXT_CACHE_SIZE; i++)
+    {
+        if (cache[i].texture.id != 0) UnloadTexture(cache[i].texture);
+    }
+
+    memset(cache, 0, sizeof(cache));
+    drawsCounter = 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Returns the cache entry of the text, rasterizing it on the least recently drawn entry if it is not cached
+static CachedText *GetCachedText (const char *text, int fontSize)
+{
+    CachedText *oldest = &cache[0];
+    Image image;
+
+    for (int i=0; i<TEXT_CACHE_SIZE; i++)
+    {
+        if (cache[i].texture.id != 0 && cache[i].fontSize == fontSize && strcmp(cache[i].text, text) == 0) return &cache[i];
+
+        if (cache[i].lastUse < oldest->lastUse) oldest = &cache[i];
+    }
+
+    if (oldest->texture.id != 0) UnloadTexture(oldest->texture);
+
+    image = ImageText(text, fontSize, WHITE);
+    oldest->texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    strcpy(oldest->text, text);
+    oldest->fontSize = fontSize;
+
+    return oldest;
+}
@@ -0,0 +1,52 @@
+/*
+*   textcache.h
+*
+*   Tap To JAmp text cache. Made by Marc Montagut - @MarcMDE
+*
+*   Text drawn with DrawCachedText() is rasterized once (ImageText) into a texture and drawn as a single
+*   quad on the next frames, until it is not drawn anymore and its entry is reused by other text.
+*   Entries are keyed by text and font size; text is rasterized in white and colored by the quad tint,
+*   so a text drawn with different colors or fading alpha is still rasterized only once.
+*
+*   Copyright (c) 2016 Marc Montagut
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+*/
+
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include "raylib.h"
+
+#define TEXT_CACHE_SIZE 32 // Cached texts, the least recently drawn one is replaced when it is full (keep it above the texts drawn per frame)
+#define TEXT_CACHE_LENGHT 64 // Max cached text lenght (including the '\0'), longer texts are drawn with DrawText()
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+// Functions
+// ----------------------------
+void DrawCachedText (const char *text, int posX, int posY, int fontSize, Color color); // Same as DrawText() (default font)
+void UnloadTextCache (void); // Unloads all the cached text textures
+// ----------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEXTCACHE_H